@@ -14,15 +14,21 @@ Device=$2
 INPUTS=$(cat $Top | grep VL_IN | sed -n '/VL_INOUT/!p' | sed -n '/__/!p')
 OUTPUTS=$(cat $Top | grep VL_OUT | sed -n '/__/!p')
 
+#-- The bus link is optional; ports reached through it need no link of their own
+echo "BusLink = configureLink(\"bus\", \"0ns\", new Event::Handler<VerilatorSST${Device}>(this, &VerilatorSST${Device}::handleBus));"
+echo "PortLinks.resize(Ports.size(), nullptr);"
+
 for IN in $INPUTS; do
   NOPAREN=$(sed 's/.*(\(.*\))/\1/' <<<$IN)
   NOPAREN2=$(echo $NOPAREN | sed 's/)//')
   REMDEPTH=$(echo $NOPAREN2 | sed 's/\[[0-9]*\]//')
   SIGNAME=$(echo $REMDEPTH | sed "s/,/ /g" | awk '{print $1}' | sed "s/&//g")
+  echo "port_${SIGNAME} = resolvePort(\"${SIGNAME}\");"
   echo "link_${SIGNAME} = configureLink(\"${SIGNAME}\", \"0ns\", new Event::Handler<VerilatorSST${Device}>(this, &VerilatorSST${Device}::handle_${SIGNAME}));"
-  echo "if( nullptr == link_${SIGNAME} ) {"
+  echo "if( nullptr == link_${SIGNAME} && nullptr == BusLink ) {"
   echo "  output->fatal( CALL_INFO, -1, \"Error: was unable to configureLink link_${SIGNAME}\n\" );"
   echo "}"
+  echo "PortLinks[port_${SIGNAME}] = link_${SIGNAME};"
 done
 
 #-- Generate all the output signals
@@ -31,10 +37,12 @@ for OUT in $OUTPUTS; do
   NOPAREN2=$(echo $NOPAREN | sed 's/)//')
   REMDEPTH=$(echo $NOPAREN2 | sed 's/\[[0-9]*\]//')
   SIGNAME=$(echo $REMDEPTH | sed "s/,/ /g" | awk '{print $1}' | sed "s/&//g")
+  echo "port_${SIGNAME} = resolvePort(\"${SIGNAME}\");"
   echo "link_${SIGNAME} = configureLink(\"${SIGNAME}\", \"0ns\", new Event::Handler<VerilatorSST${Device}>(this, &VerilatorSST${Device}::handle_${SIGNAME}));"
-  echo "if( nullptr == link_${SIGNAME} ) {"
+  echo "if( nullptr == link_${SIGNAME} && nullptr == BusLink ) {"
   echo "  output->fatal( CALL_INFO, -1, \"Error: was unable to configureLink link_${SIGNAME}\n\" );"
   echo "}"
+  echo "PortLinks[port_${SIGNAME}] = link_${SIGNAME};"
 done
 
 # -- EOF
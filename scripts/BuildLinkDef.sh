@@ -20,6 +20,7 @@ for IN in $INPUTS; do
   REMDEPTH=$(echo $NOPAREN2 | sed 's/\[[0-9]*\]//')
   SIGNAME=$(echo $REMDEPTH | sed "s/,/ /g" | awk '{print $1}' | sed "s/&//g")
   echo "SST::Link* link_${SIGNAME};"
+  echo "PortHandle port_${SIGNAME};"
 done
 
 #-- Generate all the output signals
@@ -29,6 +30,7 @@ for OUT in $OUTPUTS; do
   REMDEPTH=$(echo $NOPAREN2 | sed 's/\[[0-9]*\]//')
   SIGNAME=$(echo $REMDEPTH | sed "s/,/ /g" | awk '{print $1}' | sed "s/&//g")
   echo "SST::Link* link_${SIGNAME};"
+  echo "PortHandle port_${SIGNAME};"
 done
 
 # -- EOF
\ No newline at end of file
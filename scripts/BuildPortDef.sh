@@ -47,6 +47,9 @@ for OUT in $SAFE_OUTPUTS; do
   echo "{\"$SIGNAME\", \"Output port\", {\"SST::VerilatorSST::PortEvent\"} },"
 done
 
+#-- Batched access to all ports
+echo "{\"bus\", \"Batched port access by port handle\", {\"SST::VerilatorSST::PortBatchEvent\"} },"
+
 #-- Generate all the inout signals
 for INOUT in $INOUTS; do
   NOPAREN=$(sed 's/.*(\(.*\))/\1/' <<<$INOUT)
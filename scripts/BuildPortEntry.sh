@@ -44,7 +44,7 @@ for IN in $INPUTS; do
   ENDBIT=$(($ENDBIT + 1))
   WIDTH=$(($ENDBIT - $STARTBIT))
 
-  echo "{\"$SIGNAME\", SST::VerilatorSST::VPortType::V_INPUT, $WIDTH, $DEPTH, SST::VerilatorSST::VerilatorSST$Device::DirectWrite$SIGNAME, SST::VerilatorSST::VerilatorSST$Device::DirectRead$SIGNAME, nullptr, nullptr },"
+  echo "{\"$SIGNAME\", SST::VerilatorSST::VPortType::V_INPUT, $WIDTH, $DEPTH, SST::VerilatorSST::VerilatorSST$Device::DirectWrite$SIGNAME, SST::VerilatorSST::VerilatorSST$Device::DirectRead$SIGNAME, nullptr, nullptr, SST::VerilatorSST::VerilatorSST$Device::DirectData$SIGNAME },"
 done
 
 #-- Generate all the output signals
@@ -63,7 +63,7 @@ for OUT in $OUTPUTS; do
   ENDBIT=$(($ENDBIT + 1))
   WIDTH=$(($ENDBIT - $STARTBIT))
 
-  echo "{\"$SIGNAME\", SST::VerilatorSST::VPortType::V_OUTPUT, $WIDTH, $DEPTH, SST::VerilatorSST::VerilatorSST$Device::DirectWrite$SIGNAME, SST::VerilatorSST::VerilatorSST$Device::DirectRead$SIGNAME, nullptr, nullptr },"
+  echo "{\"$SIGNAME\", SST::VerilatorSST::VPortType::V_OUTPUT, $WIDTH, $DEPTH, SST::VerilatorSST::VerilatorSST$Device::DirectWrite$SIGNAME, SST::VerilatorSST::VerilatorSST$Device::DirectRead$SIGNAME, nullptr, nullptr, SST::VerilatorSST::VerilatorSST$Device::DirectData$SIGNAME },"
 done
 
 #-- Generate all the inout signals
@@ -82,7 +82,7 @@ for INOUT in $INOUTS; do
   ENDBIT=$(($ENDBIT + 1))
   WIDTH=$(($ENDBIT - $STARTBIT))
 
-  echo "{\"$SIGNAME\", SST::VerilatorSST::VPortType::V_INOUT, $WIDTH, $DEPTH, SST::VerilatorSST::VerilatorSST$Device::DirectWrite$SIGNAME, SST::VerilatorSST::VerilatorSST$Device::DirectRead$SIGNAME, nullptr, nullptr },"
+  echo "{\"$SIGNAME\", SST::VerilatorSST::VPortType::V_INOUT, $WIDTH, $DEPTH, SST::VerilatorSST::VerilatorSST$Device::DirectWrite$SIGNAME, SST::VerilatorSST::VerilatorSST$Device::DirectRead$SIGNAME, nullptr, nullptr, SST::VerilatorSST::VerilatorSST$Device::DirectData$SIGNAME },"
 done
 
 # -- EOF
@@ -26,37 +26,59 @@ for INPUT in $INPUTS; do
 
   if (($LINK > 0)); then
     HANDLER_IMPL="const PortEvent * portEvent = static_cast<const PortEvent *>(ev);
+  if(portEvent->getRowCount() > 0) {
+    handlePortRows(port_${SIGNAME},portEvent,link_${SIGNAME});
+    delete portEvent;
+    return;
+  }
+
   if(portEvent->getAction() == PortEventAction::WRITE) {
     if( portEvent->getAtTick() > 0 ){
-      writePortAtTick(\"${SIGNAME}\",portEvent->getPacket(),portEvent->getAtTick());
+      writePortAtTick(port_${SIGNAME},portEvent->getPacket(),portEvent->getAtTick());
     }else{
-      writePort(\"${SIGNAME}\",portEvent->getPacket());
+      writePort(port_${SIGNAME},portEvent->getPacket());
     }
     delete portEvent;
     return;
   }
 
   if(portEvent->getAction() == PortEventAction::READ) {
-    const std::vector<uint8_t> packet = readPort(\"${SIGNAME}\");
-    PortEvent * respPortEvent = new PortEvent(packet);
+    PortEvent * respPortEvent = new PortEvent(readPort(port_${SIGNAME}));
     link_${SIGNAME}->send(respPortEvent);
     delete portEvent;
     return;
   }
 
+  if(portEvent->getAction() == PortEventAction::CHANGES) {
+    sendPortChanges(port_${SIGNAME},link_${SIGNAME});
+    delete portEvent;
+    return;
+  }
+
+  if(portEvent->getAction() == PortEventAction::SUBSCRIBE) {
+    subscribePort(port_${SIGNAME},portEvent->getAtTick(),nullptr);
+    delete portEvent;
+    return;
+  }
+
+  if(portEvent->getAction() == PortEventAction::UNSUBSCRIBE) {
+    unsubscribePort(port_${SIGNAME},false);
+    delete portEvent;
+    return;
+  }
+
   output->fatal(CALL_INFO, -1, \"received port event with unrecognized action. portName=${SIGNAME} action=%u\n\",static_cast<uint8_t>(portEvent->getAction()));"
   fi
 
   if [[ "${SIGNAME}" == "${CLKNAME}" ]]; then
     HANDLER_IMPL="//clock handler
   const PortEvent * portEvent = static_cast<const PortEvent *>(ev);
-  pollWriteQueue();
-  writePort(\"${SIGNAME}\",portEvent->getPacket());
-  ContextP->timeInc(1);
+  writeClockPort(port_${SIGNAME},portEvent->getPacket().data(),portEvent->getPacket().size());
   delete portEvent;"
   fi
 
   echo "void VerilatorSST${Device}::handle_${SIGNAME}(SST::Event* ev){
+  const auto Scope = profile(Profiler::LINK);
   ${HANDLER_IMPL}
 }
 "
@@ -73,18 +95,42 @@ for OUTPUT in $OUTPUTS; do
   if (($LINK > 0)); then
     HANDLER_IMPL="const PortEvent * portEvent = static_cast<const PortEvent *>(ev);
 
+  if(portEvent->getRowCount() > 0) {
+    handlePortRows(port_${SIGNAME},portEvent,link_${SIGNAME});
+    delete portEvent;
+    return;
+  }
+
   if(portEvent->getAction() == PortEventAction::READ) {
-    const std::vector<uint8_t> packet = readPort(\"${SIGNAME}\");
-    PortEvent * respPortEvent = new PortEvent(packet);
+    PortEvent * respPortEvent = new PortEvent(readPort(port_${SIGNAME}));
     link_${SIGNAME}->send(respPortEvent);
     delete portEvent;
     return;
   }
 
+  if(portEvent->getAction() == PortEventAction::CHANGES) {
+    sendPortChanges(port_${SIGNAME},link_${SIGNAME});
+    delete portEvent;
+    return;
+  }
+
+  if(portEvent->getAction() == PortEventAction::SUBSCRIBE) {
+    subscribePort(port_${SIGNAME},portEvent->getAtTick(),nullptr);
+    delete portEvent;
+    return;
+  }
+
+  if(portEvent->getAction() == PortEventAction::UNSUBSCRIBE) {
+    unsubscribePort(port_${SIGNAME},false);
+    delete portEvent;
+    return;
+  }
+
   output->fatal(CALL_INFO, -1, \"received port event with unrecognized action. portName=${SIGNAME} action=%u\n\",static_cast<uint8_t>(portEvent->getAction()));"
   fi
 
   echo "void VerilatorSST${Device}::handle_${SIGNAME}(SST::Event* ev){
+  const auto Scope = profile(Profiler::LINK);
   ${HANDLER_IMPL}
 }
 "
@@ -19,8 +19,9 @@ for IN in $INPUTS; do
   NOPAREN2=$(echo $NOPAREN | sed 's/)//')
   REMDEPTH=$(echo $NOPAREN2 | sed 's/\[[0-9]*\]//')
   SIGNAME=$(echo $REMDEPTH | sed "s/,/ /g" | awk '{print $1}' | sed "s/&//g")
-  echo "static void DirectWrite$SIGNAME(VTop *, const std::vector<uint8_t>&);"
-  echo "static std::vector<uint8_t> DirectRead$SIGNAME(VTop *);"
+  echo "static void DirectWrite$SIGNAME(VTop *, const uint8_t *, unsigned, unsigned);"
+  echo "static void DirectRead$SIGNAME(VTop *, uint8_t *, unsigned, unsigned);"
+  echo "static const void *DirectData$SIGNAME(VTop *);"
 done
 
 #-- Generate all the output signals
@@ -29,8 +30,9 @@ for OUT in $OUTPUTS; do
   NOPAREN2=$(echo $NOPAREN | sed 's/)//')
   REMDEPTH=$(echo $NOPAREN2 | sed 's/\[[0-9]*\]//')
   SIGNAME=$(echo $REMDEPTH | sed "s/,/ /g" | awk '{print $1}' | sed "s/&//g")
-  echo "static void DirectWrite$SIGNAME(VTop *, const std::vector<uint8_t>&);"
-  echo "static std::vector<uint8_t> DirectRead$SIGNAME(VTop *);"
+  echo "static void DirectWrite$SIGNAME(VTop *, const uint8_t *, unsigned, unsigned);"
+  echo "static void DirectRead$SIGNAME(VTop *, uint8_t *, unsigned, unsigned);"
+  echo "static const void *DirectData$SIGNAME(VTop *);"
 done
 
 # -- EOF
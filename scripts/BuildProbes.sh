@@ -0,0 +1,90 @@
+#!/bin/bash
+# BuildProbes.sh
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+# See LICENSE in the top level directory for licensing details
+#
+# Generates the port table pieces of the probe points: internal signals
+# declared as NAME=hier.path at build time and reached through the
+# flattened members of the model root (rootp)
+#
+# usage: BuildProbes.sh <entry|map|io|impl> <root header> <device> <first handle> [NAME=path ...]
+
+set -e
+
+Mode=$1
+Root=$2
+Device=$3
+IDX=$4
+shift 4
+
+for PROBE in "$@"; do
+  NAME=${PROBE%%=*}
+  SIGPATH=${PROBE#*=}
+  if [[ "$NAME" == "$PROBE" ]] || [[ ! "$NAME" =~ ^[A-Za-z_][A-Za-z0-9_]*$ ]] || [[ -z "$SIGPATH" ]]; then
+    echo "invalid probe $PROBE; expected NAME=hier.path" >&2
+    exit 1
+  fi
+
+  #-- hierarchical names are flattened into the root as top__DOT__inst__DOT__sig
+  MEMBER=${SIGPATH//./__DOT__}
+  DECL=$(grep -E "[[:space:]]${MEMBER};" $Root | head -1)
+  if [ -z "$DECL" ]; then
+    echo "probe $NAME: $SIGPATH is not a member of the model root; make sure it is public and its module is inlined" >&2
+    exit 1
+  fi
+  if [ $(grep -o "VlUnpacked<" <<<"$DECL" | wc -l) -gt 1 ]; then
+    echo "probe $NAME: multi-dimensional unpacked arrays are not supported" >&2
+    exit 1
+  fi
+
+  #-- CData/*7:0*/ ..., VlWide<4>/*99:0*/ ..., VlUnpacked<IData/*31:0*/, 32> ...
+  ENDBIT=$(sed -n 's|.*/\*\([0-9]*\):\([0-9]*\)\*/.*|\1|p' <<<"$DECL")
+  STARTBIT=$(sed -n 's|.*/\*\([0-9]*\):\([0-9]*\)\*/.*|\2|p' <<<"$DECL")
+  WIDTH=$(($ENDBIT + 1 - $STARTBIT))
+  DEPTH=1
+  if [[ "$DECL" == *VlUnpacked\<* ]]; then
+    DEPTH=$(sed -n 's/.*, *\([0-9]*\)> .*/\1/p' <<<"$DECL")
+  fi
+
+  case $Mode in
+    entry)
+      echo "{\"$NAME\", SST::VerilatorSST::VPortType::V_PROBE, $WIDTH, $DEPTH, SST::VerilatorSST::VerilatorSST$Device::DirectWrite$NAME, SST::VerilatorSST::VerilatorSST$Device::DirectRead$NAME, nullptr, nullptr, SST::VerilatorSST::VerilatorSST$Device::DirectData$NAME },"
+      ;;
+    map)
+      echo "{\"$NAME\", $IDX },"
+      IDX=$(($IDX + 1))
+      ;;
+    io)
+      echo "static void DirectWrite$NAME(VTop *, const uint8_t *, unsigned, unsigned);"
+      echo "static void DirectRead$NAME(VTop *, uint8_t *, unsigned, unsigned);"
+      echo "static const void *DirectData$NAME(VTop *);"
+      ;;
+    impl)
+      if (($DEPTH > 1)); then
+        ROW="T->rootp->$MEMBER[First]"
+        BASE="T->rootp->$MEMBER[0]"
+      else
+        BASE="T->rootp->$MEMBER"
+        ROW="T->rootp->$MEMBER"
+      fi
+      echo "void VerilatorSST$Device::DirectWrite${NAME}(VTop *T, const uint8_t *Packet, unsigned First, unsigned Rows){"
+      echo "PortPacking::packRows(Packet, &$ROW, $WIDTH, sizeof($ROW), Rows);"
+      echo "}"
+      echo "void VerilatorSST$Device::DirectRead${NAME}(VTop *T, uint8_t *d, unsigned First, unsigned Rows){"
+      echo "PortPacking::unpackRows(&$ROW, d, $WIDTH, sizeof($ROW), Rows);"
+      echo "}"
+      echo "const void *VerilatorSST$Device::DirectData${NAME}(VTop *T){"
+      echo "return &$BASE;"
+      echo "}"
+      ;;
+    *)
+      echo "unknown mode $Mode" >&2
+      exit 1
+      ;;
+  esac
+done
+
+# -- EOF
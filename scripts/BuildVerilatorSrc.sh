@@ -12,6 +12,11 @@ TOP=$3
 SRC=$4
 OPTIONS=$5
 ENABLE_INOUT_HANDLING=$6
+PREFIX=${7:-VTop}
+SAVABLE=$8
+MODEL_CFLAGS=$9     # build profile compiler flags
+MODEL_MAKEVARS=${10} # build profile make variables (OPT_FAST=..., CXX=..., AR=...)
+VISIBILITY=${11---vpi --public-flat-rw} # VPI and signal visibility options
 
 if [[ "$ENABLE_INOUT_HANDLING" == "ON" ]]; then
   echo "OPTIONS = $OPTIONS"
@@ -19,8 +24,12 @@ if [[ "$ENABLE_INOUT_HANDLING" == "ON" ]]; then
   echo "OPTIONS = $OPTIONS"
 fi
 
-verilator --cc --vpi --public-flat-rw $OPTIONS -CFLAGS "-fPIC -std=c++17" --Mdir $BUILDDIR -y $SOURCEDIR --prefix VTop --top-module $TOP $SRC
+if [[ "$SAVABLE" == "ON" ]]; then
+  OPTIONS="$OPTIONS --savable"
+fi
+
+verilator --cc $VISIBILITY $OPTIONS -CFLAGS "-fPIC -std=c++17 $MODEL_CFLAGS" --Mdir $BUILDDIR -y $SOURCEDIR --prefix $PREFIX --top-module $TOP $SRC
 cd $BUILDDIR
-make -f VTop.mk
+make -f $PREFIX.mk $MODEL_MAKEVARS
 
 # EOF
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+# See LICENSE in the top level directory for licensing details
+#
+# Decodes a VerilatorSST flight recorder dump (recorderFile); prints the
+# recorded port accesses or converts them to a VCD file.
+#
+
+import argparse
+import struct
+import sys
+
+ACTIONS = { 0 : "write", 1 : "read" }
+
+class Reader:
+    """ Sequential little-endian reader over the dump bytes """
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def take(self, fmt):
+        vals = struct.unpack_from("<" + fmt, self.data, self.pos)
+        self.pos += struct.calcsize("<" + fmt)
+        return vals[0] if len(vals) == 1 else vals
+
+    def string(self):
+        n = self.take("H")
+        s = self.data[self.pos:self.pos+n].decode()
+        self.pos += n
+        return s
+
+    def bytes(self, n):
+        b = self.data[self.pos:self.pos+n]
+        self.pos += n
+        return b
+
+def decode(path):
+    with open(path, "rb") as f:
+        r = Reader(f.read())
+    magic = r.bytes(8)
+    if magic != b"VSSTREC2":
+        sys.exit(f"{path}: not a flight recorder dump")
+    dump = { "device" : r.string(), "reason" : r.string(), "ports" : [ ], "records" : [ ] }
+    for _ in range(r.take("I")):
+        dump["ports"].append((r.string(), r.take("I"), r.take("I")))
+    slotBytes = r.take("I")
+    for _ in range(r.take("Q")):
+        tick, port, action, length, row = r.take("QIBII")
+        value = r.bytes(min(length, slotBytes))
+        dump["records"].append((tick, port, action, length, value, row))
+    return dump
+
+def print_dump(dump):
+    print(f"device {dump['device']}, dumped on {dump['reason']}, {len(dump['records'])} records")
+    for tick, port, action, length, value, row in dump["records"]:
+        name, width, depth = dump["ports"][port]
+        rows = length // ((width + 7) // 8)
+        if row > 0 or rows < depth:
+            name += f"[{row}:{row + rows - 1}]"
+        hexval = value[::-1].hex()
+        more = "" if len(value) == length else f" (first {len(value)} of {length} bytes)"
+        print(f"{tick:>12} {ACTIONS.get(action, action):<5} {name} = 0x{hexval}{more}")
+
+def vcd_id(i):
+    chars = [ ]
+    while True:
+        chars.append(chr(33 + i % 94))
+        i //= 94
+        if i == 0:
+            return "".join(chars)
+
+def write_vcd(dump, path):
+    # row range records cover part of an array port and are left out
+    records = [ rec for rec in dump["records"]
+                if rec[5] == 0 and rec[3] == ((dump["ports"][rec[1]][1] + 7) // 8) * dump["ports"][rec[1]][2] ]
+    used = sorted({ port for _, port, _, _, _, _ in records })
+    ids = { port : vcd_id(i) for i, port in enumerate(used) }
+    with open(path, "w") as f:
+        f.write("$timescale 1ns $end\n")
+        f.write(f"$scope module {dump['device']} $end\n")
+        for port in used:
+            name, width, depth = dump["ports"][port]
+            bits = width if depth == 1 else ((width + 7) // 8) * 8 * depth
+            f.write(f"$var wire {bits} {ids[port]} {name} $end\n")
+        f.write("$upscope $end\n$enddefinitions $end\n")
+        last = None
+        for tick, port, _, _, value, _ in records:
+            if tick != last:
+                f.write(f"#{tick}\n")
+                last = tick
+            f.write(f"b{int.from_bytes(value, 'little'):b} {ids[port]}\n")
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a VerilatorSST flight recorder dump")
+    parser.add_argument("dump", help="Flight recorder dump file")
+    parser.add_argument("--vcd", default="", help="Write the recorded port values to this VCD file")
+    args = parser.parse_args()
+
+    dump = decode(args.dump)
+    if args.vcd:
+        write_vcd(dump, args.vcd)
+    else:
+        print_dump(dump)
+
+if __name__ == "__main__":
+    main()
+
+# EOF
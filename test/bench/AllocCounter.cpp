@@ -0,0 +1,83 @@
+//
+// _AllocCounter_cpp_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+// Counts heap allocations of a process when preloaded (LD_PRELOAD).
+// The test components read the count through vsstAllocCount() when
+// their benchReport parameter is set; see sst-bench.py.
+//
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+void* __libc_malloc(size_t Size);
+void* __libc_calloc(size_t Num, size_t Size);
+void* __libc_realloc(void* Ptr, size_t Size);
+void* __libc_memalign(size_t Align, size_t Size);
+}
+
+namespace {
+
+std::atomic<uint64_t> Allocs{0};
+
+inline void count(){
+  Allocs.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+extern "C" {
+
+uint64_t vsstAllocCount(){
+  return Allocs.load(std::memory_order_relaxed);
+}
+
+void* malloc(size_t Size){
+  count();
+  return __libc_malloc(Size);
+}
+
+void* calloc(size_t Num, size_t Size){
+  count();
+  return __libc_calloc(Num, Size);
+}
+
+void* realloc(void* Ptr, size_t Size){
+  count();
+  return __libc_realloc(Ptr, Size);
+}
+
+void* memalign(size_t Align, size_t Size){
+  count();
+  return __libc_memalign(Align, Size);
+}
+
+void* aligned_alloc(size_t Align, size_t Size){
+  count();
+  return __libc_memalign(Align, Size);
+}
+
+int posix_memalign(void** Ptr, size_t Align, size_t Size){
+  if( Align < sizeof(void*) || (Align & (Align - 1)) != 0 ){
+    return EINVAL;
+  }
+  count();
+  void* Mem = __libc_memalign(Align, Size);
+  if( !Mem ){
+    return ENOMEM;
+  }
+  *Ptr = Mem;
+  return 0;
+}
+
+} // extern "C"
+
+// EOF
@@ -0,0 +1,60 @@
+//
+// _BenchRun_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+// BENCH line of the test components (benchReport parameter), parsed by
+// sst-bench.py and the NoAllocs tests.
+//
+
+#ifndef _BENCH_RUN_H_
+#define _BENCH_RUN_H_
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <dlfcn.h>
+
+namespace SST::VerilatorSST {
+
+// -------------------------------------------------------
+// BenchRun
+// -------------------------------------------------------
+class BenchRun {
+public:
+  /// BenchRun: start the measured run
+  void start(){
+    Allocs = allocCount();
+    Start = std::chrono::steady_clock::now();
+  }
+
+  /// BenchRun: print the BENCH line for the run since start()
+  template<typename OutputT>
+  void report( OutputT& output, uint64_t Cycles, uint64_t Ops ) const {
+    const double Seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - Start ).count();
+    const int64_t Now = allocCount();
+    output.output( "BENCH cycles=%" PRIu64 " ops=%" PRIu64 " seconds=%.6f allocs=%" PRId64 "\n",
+                   Cycles, Ops, Seconds, Now < 0 ? Now : Now - Allocs );
+  }
+
+private:
+  /// BenchRun: allocations counted by the preloaded vsst-alloc-count library; -1 without it
+  static int64_t allocCount(){
+    using CountFunc = uint64_t (*)();
+    static const CountFunc Count = reinterpret_cast<CountFunc>( dlsym( RTLD_DEFAULT, "vsstAllocCount" ) );
+    return Count ? static_cast<int64_t>( Count() ) : -1;
+  }
+
+  int64_t Allocs = 0;                              ///< BenchRun: allocation count at start
+  std::chrono::steady_clock::time_point Start;     ///< BenchRun: host time at start
+};  // class BenchRun
+
+}  // namespace SST::VerilatorSST
+
+#endif  // _BENCH_RUN_H_
+
+// EOF
@@ -0,0 +1,360 @@
+//
+// _PackingBench_cpp_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+// Compares the PortPacking kernels against the per-byte loops they
+// replaced, and verifies every kernel set against those loops.
+//
+//   packing-bench            run the verification and the benchmark
+//   packing-bench --verify   run the verification only
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "PortPacking.h"
+
+using namespace SST::VerilatorSST;
+
+namespace {
+
+const unsigned Widths[] = {1, 33, 64, 128, 512};
+const uint64_t Depths[] = {1, 16, 256, 4096};
+const PortPacking::Kernel Kernels[] = {
+  PortPacking::Kernel::SCALAR, PortPacking::Kernel::SSE, PortPacking::Kernel::AVX2
+};
+
+// model element size Verilator uses for a port of the given width
+unsigned elementStride(unsigned Bits){
+  if( Bits <= 8 )  return 1;
+  if( Bits <= 16 ) return 2;
+  if( Bits <= 32 ) return 4;
+  if( Bits <= 64 ) return 8;
+  return 4 * PortPacking::getNumWords(Bits);
+}
+
+// ---------------------------------------------------------------
+// Legacy loops: the shift chains formerly emitted by BuildPortIOImpls.sh
+// and the per-row temporaries of the original Signal conversion
+// ---------------------------------------------------------------
+void legacyWrite(const uint8_t* Packet, uint8_t* Model, unsigned Bits, unsigned Stride, uint64_t Depth){
+  const unsigned Bytes = PortPacking::getNumBytes(Bits);
+  for( uint64_t i=0; i<Depth; i++ ){
+    const uint8_t* P = Packet + i*Bytes;
+    uint8_t* M = Model + i*Stride;
+    if( Bits <= 64 ){
+      uint64_t tmp = 0;
+      for( int b=Bytes-1; b>=0; b-- ){
+        tmp = (tmp<<8) + (((uint64_t)P[b]) & 255);
+      }
+      const uint64_t Mask = (Bits < 64) ? ((1ull << Bits) - 1) : ~0ull;
+      tmp &= Mask;
+      std::memcpy(M, &tmp, Stride);
+    }else{
+      uint32_t* W = reinterpret_cast<uint32_t*>(M);
+      const unsigned Words = Bits / 32;
+      for( unsigned w=0; w<Words; w++ ){
+        uint32_t tmp = 0;
+        for( int b=3; b>=0; b-- ){
+          tmp = (tmp<<8) + (((uint32_t)P[w*4+b]) & 255);
+        }
+        W[w] = tmp;
+      }
+      if( Bits % 32 ){
+        uint32_t tmp = 0;
+        for( int b=(int)(Bytes-Words*4)-1; b>=0; b-- ){
+          tmp = (tmp<<8) + (((uint32_t)P[Words*4+b]) & 255);
+        }
+        W[Words] = tmp & ((1u << (Bits % 32)) - 1);
+      }
+    }
+  }
+}
+
+void legacyRead(const uint8_t* Model, std::vector<uint8_t>& d, unsigned Bits, unsigned Stride, uint64_t Depth){
+  const unsigned Bytes = PortPacking::getNumBytes(Bits);
+  d.clear();
+  for( uint64_t i=0; i<Depth; i++ ){
+    const uint8_t* M = Model + i*Stride;
+    if( Bits <= 64 ){
+      uint64_t v = 0;
+      std::memcpy(&v, M, Stride);
+      for( unsigned b=0; b<Bytes; b++ ){
+        d.push_back((v >> (b*8)) & 255);
+      }
+    }else{
+      const uint32_t* W = reinterpret_cast<const uint32_t*>(M);
+      for( unsigned b=0; b<Bytes; b++ ){
+        d.push_back((W[b/4] >> ((b%4)*8)) & 255);
+      }
+    }
+  }
+}
+
+void legacyPackVecval(const std::vector<uint8_t>& Src, unsigned Bits, uint64_t Depth,
+                      std::vector<s_vpi_value>& Rows){
+  const unsigned Bytes = PortPacking::getNumBytes(Bits);
+  const unsigned Words = PortPacking::getNumWords(Bits);
+  std::vector<uint32_t> Buf(Words*Depth);
+  for( uint64_t i=0; i<Depth; i++ ){
+    auto RowBuf = std::vector<uint32_t>(Words);
+    for( unsigned k=0; k<Bytes; k++ ){
+      reinterpret_cast<uint8_t*>(RowBuf.data())[k] = Src[i*Bytes+k];
+    }
+    for( unsigned j=0; j<Words; j++ ){
+      Buf[i*Words+j] = RowBuf[j];
+    }
+  }
+  Rows.resize(Depth);
+  for( uint64_t i=0; i<Depth; i++ ){
+    s_vpi_value& Row = Rows[Depth-i-1];
+    Row.format = vpiVectorVal;
+    Row.value.vector = new s_vpi_vecval[Words];
+    for( unsigned k=0; k<Words; k++ ){
+      Row.value.vector[k].aval = Buf[i*Words+k];
+      Row.value.vector[k].bval = 0;
+    }
+  }
+}
+
+void legacyUnpackVecval(const std::vector<s_vpi_value>& Rows, unsigned Bits, uint64_t Depth,
+                        std::vector<uint8_t>& Dst){
+  const unsigned Bytes = PortPacking::getNumBytes(Bits);
+  const unsigned Words = PortPacking::getNumWords(Bits);
+  std::vector<uint32_t> Buf(Words*Depth);
+  for( uint64_t i=0; i<Depth; i++ ){
+    const s_vpi_value& Row = Rows[Depth-i-1];
+    for( unsigned j=0; j<Words; j++ ){
+      Buf[i*Words+j] = Row.value.vector[j].aval;
+    }
+  }
+  Dst.assign(Bytes*Depth, 0);
+  for( uint64_t i=0; i<Depth; i++ ){
+    auto RowBuf = std::vector<uint8_t>(Bytes);
+    for( unsigned j=0; j<Words; j++ ){
+      for( unsigned k=0; k<4 && j*4+k<Bytes; k++ ){
+        RowBuf[j*4+k] = reinterpret_cast<const uint8_t*>(&Buf[i*Words+j])[k];
+      }
+    }
+    std::memcpy(&Dst[i*Bytes], RowBuf.data(), Bytes);
+  }
+}
+
+void freeRows(std::vector<s_vpi_value>& Rows){
+  for( auto& Row : Rows ){
+    delete[] Row.value.vector;
+  }
+  Rows.clear();
+}
+
+// ---------------------------------------------------------------
+// Verification
+// ---------------------------------------------------------------
+std::vector<uint8_t> randomBytes(size_t N, std::mt19937& Gen){
+  std::vector<uint8_t> V(N);
+  for( auto& B : V ){
+    B = static_cast<uint8_t>(Gen());
+  }
+  return V;
+}
+
+bool verifyKernel(PortPacking::Kernel K, std::mt19937& Gen){
+  unsigned Fails = 0;
+  for( unsigned Bits = 1; Bits <= 520; Bits += (Bits < 70 ? 1 : 13) ){
+    const unsigned Bytes = PortPacking::getNumBytes(Bits);
+    const unsigned Words = PortPacking::getNumWords(Bits);
+    const unsigned Stride = elementStride(Bits);
+    for( uint64_t Depth : {1, 2, 3, 5, 8, 17, 33, 100} ){
+      const auto Packet = randomBytes(Bytes*Depth, Gen);
+
+      // direct: compare against the legacy shift chains
+      std::vector<uint8_t> Ref(Stride*Depth, 0xA5), Got(Stride*Depth, 0xA5);
+      legacyWrite(Packet.data(), Ref.data(), Bits, Stride, Depth);
+      PortPacking::packRows(Packet.data(), Got.data(), Bits, Stride, Depth);
+      if( Ref != Got ){
+        Fails++;
+        std::printf("FAIL %s packRows bits=%u depth=%" PRIu64 "\n", PortPacking::getKernelName(K), Bits, Depth);
+      }
+
+      std::vector<uint8_t> RefRead, GotRead(Bytes*Depth + 32, 0x5A);
+      legacyRead(Ref.data(), RefRead, Bits, Stride, Depth);
+      PortPacking::unpackRows(Ref.data(), GotRead.data(), Bits, Stride, Depth);
+      if( !std::equal(RefRead.begin(), RefRead.end(), GotRead.begin()) ||
+          GotRead[Bytes*Depth] != 0x5A ){
+        Fails++;
+        std::printf("FAIL %s unpackRows bits=%u depth=%" PRIu64 "\n", PortPacking::getKernelName(K), Bits, Depth);
+      }
+
+      // vpi: compare against the legacy Signal conversion (descending rows)
+      std::vector<s_vpi_value> RefRows;
+      legacyPackVecval(Packet, Bits, Depth, RefRows);
+      std::vector<s_vpi_vecval> Vec(Words*Depth);
+      PortPacking::packVecval(Packet.data(), Vec.data(), Bits, Depth, true);
+      for( uint64_t i=0; i<Depth; i++ ){
+        if( std::memcmp(&Vec[i*Words], RefRows[i].value.vector, Words*sizeof(s_vpi_vecval)) ){
+          Fails++;
+          std::printf("FAIL %s packVecval bits=%u depth=%" PRIu64 " row=%" PRIu64 "\n",
+                      PortPacking::getKernelName(K), Bits, Depth, i);
+          break;
+        }
+      }
+
+      std::vector<uint8_t> RefUnpacked, GotUnpacked(Bytes*Depth + 32, 0x5A);
+      legacyUnpackVecval(RefRows, Bits, Depth, RefUnpacked);
+      PortPacking::unpackVecval(Vec.data(), GotUnpacked.data(), Bits, Depth, true);
+      if( !std::equal(RefUnpacked.begin(), RefUnpacked.end(), GotUnpacked.begin()) ||
+          GotUnpacked[Bytes*Depth] != 0x5A ){
+        Fails++;
+        std::printf("FAIL %s unpackVecval bits=%u depth=%" PRIu64 "\n", PortPacking::getKernelName(K), Bits, Depth);
+      }
+      freeRows(RefRows);
+
+      // dirty rows: change a few elements and compare against a per-row memcmp
+      std::vector<uint8_t> Model = randomBytes(Stride*Depth, Gen);
+      std::vector<uint8_t> Shadow = Model;
+      for( uint64_t i=0; i<Depth; i+=1+Gen()%4 ){
+        Model[i*Stride + Gen()%Stride] ^= static_cast<uint8_t>(1 + Gen()%255);
+      }
+      std::vector<uint64_t> RefDirty((Depth+63)/64, 0), GotDirty((Depth+63)/64, 0);
+      for( uint64_t i=0; i<Depth; i++ ){
+        if( std::memcmp(&Model[i*Stride], &Shadow[i*Stride], Stride) ){
+          RefDirty[i/64] |= 1ull << (i%64);
+        }
+      }
+      PortPacking::diffRows(Model.data(), Shadow.data(), Stride, Depth, GotDirty.data());
+      if( GotDirty != RefDirty || Shadow != Model ){
+        Fails++;
+        std::printf("FAIL %s diffRows bits=%u depth=%" PRIu64 "\n", PortPacking::getKernelName(K), Bits, Depth);
+      }
+
+      // forward row order round trip
+      std::vector<uint8_t> Round(Bytes*Depth);
+      PortPacking::packVecval(Packet.data(), Vec.data(), Bits, Depth, false);
+      PortPacking::unpackVecval(Vec.data(), Round.data(), Bits, Depth, false);
+      if( Round != Packet ){
+        Fails++;
+        std::printf("FAIL %s vecval round trip bits=%u depth=%" PRIu64 "\n", PortPacking::getKernelName(K), Bits, Depth);
+      }
+    }
+  }
+  return Fails == 0;
+}
+
+// ---------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------
+template<typename F>
+double nsPerRow(uint64_t Depth, F&& Fn){
+  using Clock = std::chrono::steady_clock;
+  const uint64_t Target = 1u << 21;    // rows per measurement
+  const uint64_t Iters = std::max<uint64_t>(Target / Depth, 16);
+  Fn();
+  const auto Start = Clock::now();
+  for( uint64_t i=0; i<Iters; i++ ){
+    Fn();
+  }
+  const std::chrono::duration<double, std::nano> Elapsed = Clock::now() - Start;
+  return Elapsed.count() / (double)(Iters * Depth);
+}
+
+volatile uint8_t Sink;
+
+void benchmark(std::mt19937& Gen){
+  std::printf("\n%-8s %6s %6s %-8s %12s %12s %12s %12s\n",
+              "path", "bits", "depth", "kernel", "pack ns/row", "unpack ns/r", "legacy pack", "legacy unp");
+  for( unsigned Bits : Widths ){
+    for( uint64_t Depth : Depths ){
+      const unsigned Bytes = PortPacking::getNumBytes(Bits);
+      const unsigned Words = PortPacking::getNumWords(Bits);
+      const unsigned Stride = elementStride(Bits);
+      const auto Packet = randomBytes(Bytes*Depth, Gen);
+      std::vector<uint8_t> Model(Stride*Depth), Out(Bytes*Depth);
+      std::vector<s_vpi_vecval> Vec(Words*Depth);
+      std::vector<uint8_t> LegacyOut;
+
+      const double LegacyPack = nsPerRow(Depth, [&]{
+        legacyWrite(Packet.data(), Model.data(), Bits, Stride, Depth); Sink = Model[0]; });
+      const double LegacyUnpack = nsPerRow(Depth, [&]{
+        legacyRead(Model.data(), LegacyOut, Bits, Stride, Depth); Sink = LegacyOut[0]; });
+      std::vector<s_vpi_value> Rows;
+      const double LegacyVpiPack = nsPerRow(Depth, [&]{
+        legacyPackVecval(Packet, Bits, Depth, Rows); Sink = Rows[0].value.vector[0].aval; freeRows(Rows); });
+      legacyPackVecval(Packet, Bits, Depth, Rows);
+      const double LegacyVpiUnpack = nsPerRow(Depth, [&]{
+        legacyUnpackVecval(Rows, Bits, Depth, LegacyOut); Sink = LegacyOut[0]; });
+      freeRows(Rows);
+
+      for( auto K : Kernels ){
+        if( !PortPacking::setKernel(K) ){
+          continue;
+        }
+        const double Pack = nsPerRow(Depth, [&]{
+          PortPacking::packRows(Packet.data(), Model.data(), Bits, Stride, Depth); Sink = Model[0]; });
+        const double Unpack = nsPerRow(Depth, [&]{
+          PortPacking::unpackRows(Model.data(), Out.data(), Bits, Stride, Depth); Sink = Out[0]; });
+        std::printf("%-8s %6u %6" PRIu64 " %-8s %12.3f %12.3f %12.3f %12.3f\n", "direct", Bits, Depth,
+                    PortPacking::getKernelName(K), Pack, Unpack, LegacyPack, LegacyUnpack);
+
+        const double VpiPack = nsPerRow(Depth, [&]{
+          PortPacking::packVecval(Packet.data(), Vec.data(), Bits, Depth, true); Sink = Vec[0].aval; });
+        const double VpiUnpack = nsPerRow(Depth, [&]{
+          PortPacking::unpackVecval(Vec.data(), Out.data(), Bits, Depth, true); Sink = Out[0]; });
+        std::printf("%-8s %6u %6" PRIu64 " %-8s %12.3f %12.3f %12.3f %12.3f\n", "vpi", Bits, Depth,
+                    PortPacking::getKernelName(K), VpiPack, VpiUnpack, LegacyVpiPack, LegacyVpiUnpack);
+
+        // dirty row scan of an unchanged port against a per-row memcmp
+        std::vector<uint8_t> Shadow = Model;
+        std::vector<uint64_t> Dirty((Depth+63)/64);
+        const double Diff = nsPerRow(Depth, [&]{
+          PortPacking::diffRows(Model.data(), Shadow.data(), Stride, Depth, Dirty.data()); Sink = Shadow[0]; });
+        const double LegacyDiff = nsPerRow(Depth, [&]{
+          for( uint64_t i=0; i<Depth; i++ ){
+            if( std::memcmp(&Model[i*Stride], &Shadow[i*Stride], Stride) ){
+              Dirty[i/64] |= 1ull << (i%64);
+            }
+          }
+          Sink = static_cast<uint8_t>(Dirty[0]); });
+        std::printf("%-8s %6u %6" PRIu64 " %-8s %12.3f %12s %12.3f %12s\n", "diff", Bits, Depth,
+                    PortPacking::getKernelName(K), Diff, "-", LegacyDiff, "-");
+      }
+    }
+  }
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv){
+  const bool VerifyOnly = (argc > 1) && (std::string(argv[1]) == "--verify");
+  std::mt19937 Gen(0x5eed);
+  const PortPacking::Kernel Default = PortPacking::getKernel();
+  std::printf("default kernel: %s\n", PortPacking::getKernelName(Default));
+
+  bool Ok = true;
+  for( auto K : Kernels ){
+    if( !PortPacking::setKernel(K) ){
+      std::printf("verify %-8s skipped (unsupported)\n", PortPacking::getKernelName(K));
+      continue;
+    }
+    const bool KernelOk = verifyKernel(K, Gen);
+    std::printf("verify %-8s %s\n", PortPacking::getKernelName(K), KernelOk ? "ok" : "FAILED");
+    Ok = Ok && KernelOk;
+  }
+
+  if( Ok && !VerifyOnly ){
+    benchmark(Gen);
+  }
+  PortPacking::setKernel(Default);
+  return Ok ? 0 : 1;
+}
+
+// EOF
@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+# See LICENSE in the top level directory for licensing details
+#
+# sst-bench.py
+#
+# Throughput benchmark of the generated subcomponents. Runs the
+# verilator-test-component.py workloads for each model and interface and
+# reports simulated cycles/sec, port ops/sec, heap allocations per cycle
+# and peak RSS. Rates cover the simulation run only (setup to finish), so
+# the Python op generation does not count. direct-novpi runs the models
+# also built with VISIBILITY none and reports their speedup over direct.
+#
+#   sst-bench.py --preload libvsst-alloc-count.so --json bench.json
+#   sst-bench.py --baseline baseline.json --update-baseline
+#   sst-bench.py --baseline baseline.json --tolerance 0.2
+#
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+MODELS = ["Counter", "Accum", "Accum1D", "Scratchpad", "UART", "PicoRV"]
+MODES = {
+    "direct"     : ["-i", "direct"],
+    "links"      : ["-i", "links"],
+    "direct-vpi" : ["-i", "direct", "-a", "vpi"],
+    "links-vpi"  : ["-i", "links", "-a", "vpi"],
+    "direct-novpi" : ["-i", "direct", "--variant", "NoVPI"],
+}
+# modes that need a dedicated build variant of the model (test/CMakeLists.txt)
+VARIANT_MODELS = { "direct-novpi" : ["PicoRV"] }
+TEST_SCRIPT = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                           "..", "test_elements", "verilator-test-component.py")
+# exit status when there is no baseline to compare against (CTest SKIP_RETURN_CODE)
+SKIP_NO_BASELINE = 77
+BENCH_LINE = re.compile(r"BENCH cycles=(\d+) ops=(\d+) seconds=([0-9.]+) allocs=(-?\d+)")
+
+def run_once(args, model, mode):
+    """ Run one simulation; returns its BENCH values and peak RSS """
+    cmd = [args.sst, TEST_SCRIPT, "--", "-m", model, *MODES[mode],
+           "-c", str(args.cycles), "-v", "0", "--bench"]
+    env = dict(os.environ)
+    if args.preload:
+        env["LD_PRELOAD"] = os.path.abspath(args.preload)
+    # statistics output lands in the working directory
+    with tempfile.TemporaryDirectory() as cwd:
+        proc = subprocess.Popen(cmd, cwd=cwd, env=env, text=True,
+                                stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        out = proc.stdout.read()
+        _, status, usage = os.wait4(proc.pid, 0)
+        proc.returncode = os.waitstatus_to_exitcode(status)
+    match = BENCH_LINE.search(out)
+    if proc.returncode != 0 or not match:
+        sys.stderr.write(out[-2000:])
+        raise RuntimeError(f"{model}/{mode}: sst exited with {proc.returncode}")
+    cycles, ops, seconds, allocs = match.groups()
+    return int(cycles), int(ops), max(float(seconds), 1e-9), int(allocs), usage.ru_maxrss
+
+def run_bench(args, model, mode):
+    """ Best of args.repeat runs; peak RSS is the largest seen """
+    best = None
+    rss = 0
+    for _ in range(args.repeat):
+        cycles, ops, seconds, allocs, maxrss = run_once(args, model, mode)
+        rss = max(rss, maxrss)
+        if best is None or seconds < best[2]:
+            best = (cycles, ops, seconds, allocs)
+    cycles, ops, seconds, allocs = best
+    return {
+        "model" : model,
+        "mode" : mode,
+        "cycles" : cycles,
+        "ops" : ops,
+        "seconds" : seconds,
+        "cycles_per_sec" : cycles / seconds,
+        "events_per_sec" : ops / seconds,
+        "allocs_per_cycle" : allocs / cycles if allocs >= 0 and cycles else None,
+        "peak_rss_kb" : rss,
+    }
+
+def compare(results, baseline, tolerance):
+    """ Print the throughput change against the baseline; returns the regressed runs """
+    base = { (r["model"], r["mode"]) : r for r in baseline["results"] }
+    regressed = [ ]
+    for r in results:
+        b = base.get((r["model"], r["mode"]))
+        if not b:
+            print(f"{r['model']:<11} {r['mode']:<12} no baseline")
+            continue
+        ratio = r["cycles_per_sec"] / b["cycles_per_sec"]
+        flag = "REGRESSION" if ratio < 1.0 - tolerance else "ok"
+        print(f"{r['model']:<11} {r['mode']:<12} {ratio:6.2f}x baseline  {flag}")
+        if ratio < 1.0 - tolerance:
+            regressed.append(r)
+    return regressed
+
+def visibility_speedup(results):
+    """ Print the cycles/sec gain of the VISIBILITY none builds over the direct ones """
+    direct = { r["model"] : r for r in results if r["mode"] == "direct" }
+    for r in results:
+        if r["mode"] == "direct-novpi" and r["model"] in direct:
+            ratio = r["cycles_per_sec"] / direct[r["model"]]["cycles_per_sec"]
+            print(f"{r['model']:<11} VISIBILITY none speedup over --public-flat-rw: {ratio:.2f}x")
+
+def main():
+    parser = argparse.ArgumentParser(description="Throughput benchmark of the generated VerilatorSST subcomponents")
+    parser.add_argument("--sst", default="sst", help="sst executable")
+    parser.add_argument("-m", "--models", nargs="+", choices=MODELS, default=MODELS, help="Models to run")
+    parser.add_argument("-i", "--modes", nargs="+", choices=list(MODES), default=list(MODES), help="Interfaces to run")
+    parser.add_argument("-c", "--cycles", type=int, default=20000, help="Simulated cycles per run")
+    parser.add_argument("-r", "--repeat", type=int, default=3, help="Runs per configuration; the fastest is reported")
+    parser.add_argument("--preload", default="", help="Allocation counter library (libvsst-alloc-count.so) to preload")
+    parser.add_argument("--json", default="", help="Write the results to this JSON file")
+    parser.add_argument("--baseline", default="", help="Baseline JSON file to compare throughput against")
+    parser.add_argument("--update-baseline", action="store_true", help="Write the results to --baseline instead of comparing")
+    parser.add_argument("--tolerance", type=float, default=0.2, help="Allowed fractional cycles/sec drop against the baseline")
+    args = parser.parse_args()
+
+    # without a baseline there is nothing to pass or fail; skip before running
+    if args.baseline and not args.update_baseline and not os.path.exists(args.baseline):
+        print(f"no baseline at {args.baseline}; run with --update-baseline to record one")
+        return SKIP_NO_BASELINE
+
+    results = [ ]
+    print(f"{'model':<11} {'mode':<12} {'cycles/s':>12} {'events/s':>12} {'allocs/cyc':>10} {'rss MB':>8}")
+    for model in args.models:
+        for mode in args.modes:
+            if mode in VARIANT_MODELS and model not in VARIANT_MODELS[mode]:
+                continue
+            r = run_bench(args, model, mode)
+            allocs = "n/a" if r["allocs_per_cycle"] is None else f"{r['allocs_per_cycle']:.2f}"
+            print(f"{model:<11} {mode:<12} {r['cycles_per_sec']:12.0f} {r['events_per_sec']:12.0f} "
+                  f"{allocs:>10} {r['peak_rss_kb'] / 1024:8.1f}", flush=True)
+            results.append(r)
+    visibility_speedup(results)
+
+    report = { "cycles" : args.cycles, "results" : results }
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(report, f, indent=2)
+
+    if not args.baseline:
+        return 0
+    if args.update_baseline:
+        with open(args.baseline, "w") as f:
+            json.dump(report, f, indent=2)
+        print(f"baseline written to {args.baseline}")
+        return 0
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    if baseline.get("cycles") != args.cycles:
+        print(f"note: baseline was recorded with {baseline.get('cycles')} cycles per run")
+    regressed = compare(results, baseline, args.tolerance)
+    return 1 if regressed else 0
+
+if __name__ == "__main__":
+    sys.exit(main())
+
+# EOF
@@ -0,0 +1,41 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+# See LICENSE in the top level directory for licensing details
+#
+# Checks that an FST waveform covers exactly the ticks [start, stop]. The
+# times are read from the FST header block, which the writer rewrites with
+# the first and last dumped times when the trace is closed.
+#
+
+import argparse
+import struct
+import sys
+
+FST_BL_HDR = 0
+
+def main():
+    parser = argparse.ArgumentParser(description="Check the dumped time window of an FST file")
+    parser.add_argument("fst", help="FST file written with traceFile")
+    parser.add_argument("start", type=int, help="Expected first dumped tick (traceStart)")
+    parser.add_argument("stop", type=int, help="Expected last dumped tick (traceStop)")
+    args = parser.parse_args()
+
+    with open(args.fst, "rb") as f:
+        hdr = f.read(25)
+    if len(hdr) < 25 or hdr[0] != FST_BL_HDR:
+        print(f"{args.fst}: not an FST file", file=sys.stderr)
+        return 1
+
+    # block type, section length, start time, end time; big-endian
+    _, start, end = struct.unpack_from(">QQQ", hdr, 1)
+    print(f"{args.fst}: ticks {start} to {end}")
+    if start != args.start or end != args.stop:
+        print(f"{args.fst}: expected ticks {args.start} to {args.stop}", file=sys.stderr)
+        return 1
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -10,8 +10,11 @@
 
 import sst
 import argparse
+import os
 import queue
 import random
+import struct
+import tempfile
 from enum import Enum
 from enum import IntEnum
 
@@ -31,6 +34,7 @@ UART_BAUD_PERIOD = 4 # Should be one more than the verilog param
 class OpAction(Enum):
     Write = "write"
     Read  = "read"
+    Changes = "changes"
 
 class VerboseMasking(IntEnum):
     WRITE_EVENT  = 0b0000_0000_0001
@@ -56,9 +60,10 @@ class PortDef:
         self.PortNames = [ ]
 
     # portName is a string, portSize is an int (measured in bytes), portDir
-    # should use READ_PORT, WRITE_PORT, or INOUT_PORT globals
-    def addPort(self, portName, portSize, portDir):
-        tmp = f"{portName}:{self.PortId}:{portSize}:{portDir}"
+    # should use READ_PORT, WRITE_PORT, or INOUT_PORT globals; portDepth is
+    # the row count of an array port, which portSize covers in full
+    def addPort(self, portName, portSize, portDir, portDepth=1):
+        tmp = f"{portName}:{self.PortId}:{portSize}:{portDir}:{portDepth}"
         self.PortList.append(tmp)
         self.PortNames.append(portName)
         self.PortId = self.PortId + 1
@@ -73,6 +78,71 @@ class PortDef:
         return( self.PortNames[index] )
 
 
+# Trace window of --trace; test/CMakeLists.txt checks the FST against it
+TRACE_START = 20
+TRACE_STOP = 60
+
+# Flight recorder ring size of --recorder; every test run wraps it
+RECORDER_ENTRIES = 16
+
+# Writes a memory image of the raw bytes in image to path, in the format named by
+# its extension (.hex, .elf or raw), and the raw bytes the RAM should then hold to
+# path.expected. Returns the expected bytes and the memInit port prefix.
+ELF_BASE = 0x8000_0000
+def writeMemImage(path, image):
+    image = bytearray(image)
+    port = "mem"
+    if path.endswith(".hex"):
+        with open(path, "w") as f:
+            f.write("// Scratchpad image, one byte per row\n")
+            for row in range(0, len(image), 16):
+                if row % 4096 == 0:
+                    f.write(f"@{row:x} /* chunk */\n")
+                f.write(" ".join(f"{b:02x}" for b in image[row:row+16]) + "\n")
+    elif path.endswith(".elf"):
+        # two segments at ELF_BASE: the first ends in 4 KiB of bss, followed
+        # by a 4 KiB gap; both load as zeros
+        half = len(image) // 2
+        image[half-4096:half+4096] = bytes(8192)
+        segs = [(0, half - 4096, half), (half + 4096, len(image) - half - 4096, len(image) - half - 4096)]
+        ehsize, phsize = 52, 32
+        data = bytearray(b"\x7fELF" + bytes([1, 1, 1]) + bytes(9))
+        data += struct.pack("<HHIIIIIHHHHHH", 2, 0xF3, 1, ELF_BASE, ehsize, 0, 0,
+                            ehsize, phsize, len(segs), 0, 0, 0)
+        offset = ehsize + phsize * len(segs)
+        for (addr, filesz, memsz) in segs:
+            data += struct.pack("<IIIIIIII", 1, offset, ELF_BASE + addr, ELF_BASE + addr,
+                                filesz, memsz, 5, 4)
+            offset += filesz
+        for (addr, filesz, memsz) in segs:
+            data += image[addr:addr+filesz]
+        with open(path, "wb") as f:
+            f.write(data)
+        port = f"mem@{ELF_BASE:#x}"
+    else:
+        with open(path, "wb") as f:
+            f.write(image)
+    with open(path + ".expected", "wb") as f:
+        f.write(image)
+    return bytes(image), port
+
+# Counter ops of buildCounterTest from forkTick on, with stop held at a new
+# value; the links test reads the count (t-3)%8 at tick t once reset is released
+def counterForkVariant(ops, forkTick, stop):
+    variant = [ ]
+    for op in ops:
+        port, action, value, tick = op.split(":")
+        tick = int(tick)
+        if ( port == "done" or port == "stop" ):
+            continue
+        variant.append(op)
+        if ( port == "clk" and value == "1" ):
+            if ( tick == forkTick ):
+                variant.append(f"stop:{OpAction.Write.value}:{stop}:{tick}")
+            else:
+                variant.append(f"done:{OpAction.Read.value}:{int((tick - 3) % 8 == stop)}:{tick}")
+    return variant
+
 def randIntBySize(size):
     tmp = 2**(size*8) - 1
     return(random.randrange(tmp))
@@ -145,6 +215,25 @@ class Test:
                 self.addTestOp("en", OpAction.Write, 0, i)
             self.addTestOp("clk", OpAction.Write, 0, i)
 
+    # reads of the Scratchpad RAM preloaded from image (bytes), without any writes
+    def buildScratchImageTest(self, numCycles, image):
+        global SCRATCH_ADDR_BASE
+        global SCRATCH_SIZE
+        randAddr = 0
+        for i in range(numCycles):
+            self.addTestOp("clk", OpAction.Write, 1, i)
+            if (i % 4 == 1):
+                randAddr = random.randrange(1, SCRATCH_SIZE - 8)
+                self.addTestOp("write", OpAction.Write, 0, i)
+                self.addTestOp("addr", OpAction.Write, SCRATCH_ADDR_BASE + randAddr, i)
+                self.addTestOp("len", OpAction.Write, 3, i)
+                self.addTestOp("en", OpAction.Write, 1, i)
+            elif (i % 4 == 2):
+                expected = int.from_bytes(image[randAddr:randAddr+8], "little")
+                self.addTestOp("rdata", OpAction.Read, expected, i)
+                self.addTestOp("en", OpAction.Write, 0, i)
+            self.addTestOp("clk", OpAction.Write, 0, i)
+
     def buildAccum1DTest(self, numCycles):
         global UINT64_MAX
         self.addTestOp("reset_l", OpAction.Write, 0, 1)
@@ -173,7 +262,7 @@ class Test:
                 self.addTestOp("en", OpAction.Write, 0, i)
             self.addTestOp("clk", OpAction.Write, 0, i) # cycle clock every cycle
      
-    def buildAccumTest(self, numCycles):
+    def buildAccumTest(self, numCycles, probes=False, rows=False, changes=False):
         global UINT64_MAX
         self.addTestOp("reset_l", OpAction.Write, 1, 0)
         self.addTestOp("reset_l", OpAction.Write, 0, 1)
@@ -191,6 +280,11 @@ class Test:
                 add[1] = randIntBySize(2)
                 add[2] = randIntBySize(2)
                 add[3] = randIntBySize(2)
+                if changes:
+                    # leave half of the accum rows unchanged so the changes reads skip them
+                    for r in range(4):
+                        if (i // 3 + r) % 2:
+                            add[r] = 0
                 bigAdd = (add[3] << 48) + (add[2] << 32) + (add[1] << 16) + add[0]
                 accum[0] += add[0]
                 accum[1] += add[1]
@@ -198,11 +292,26 @@ class Test:
                 accum[3] += add[3]
                 bigAccum[0] = accum[0] + (accum[1] << 32)
                 bigAccum[1] = accum[2] + (accum[3] << 32)
-                self.addTestOp("add", OpAction.Write, bigAdd, i)
+                if rows:
+                    # the same adds as two "name[first-last]" row range writes
+                    self.addTestOp("add[0-1]", OpAction.Write, (add[1] << 16) + add[0], i)
+                    self.addTestOp("add[2-3]", OpAction.Write, (add[3] << 16) + add[2], i)
+                else:
+                    self.addTestOp("add", OpAction.Write, bigAdd, i)
                 self.addTestOp("en", OpAction.Write, 1, i)
             elif (i % 3 == 2):
                 self.addBigTestOp("accum", OpAction.Read, bigAccum, i)
+                if changes:
+                    # rebuilt from the changed rows only
+                    self.addBigTestOp("accum", OpAction.Changes, bigAccum, i)
+                if rows:
+                    for r in range(4):
+                        self.addTestOp(f"accum[{r}-{r}]", OpAction.Read, accum[r], i)
                 self.addTestOp("done", OpAction.Read, 1, i)
+                if probes:
+                    # the registers behind accum and done (AccumDirect PROBES)
+                    self.addBigTestOp("accumulator", OpAction.Read, bigAccum, i)
+                    self.addTestOp("doner", OpAction.Read, 1, i)
                 self.addTestOp("en", OpAction.Write, 0, i)
             self.addTestOp("clk", OpAction.Write, 0, i) # cycle clock every cycle
 
@@ -462,6 +571,22 @@ class Test:
 
           
 
+    # Subscribe to portName on change from tick 0 and unsubscribe at unsubTick,
+    # ahead of the other ops of those ticks
+    def addSubscription(self, portName, unsubTick):
+        self.TestOps.insert(0, f"{portName}:subscribe:0:0")
+        at = next((i for i, op in enumerate(self.TestOps) if int(op.split(":")[-1]) >= unsubTick), len(self.TestOps))
+        self.TestOps.insert(at, f"{portName}:unsubscribe:0:{unsubTick}")
+
+    # Flip the expected value of the last single-value read
+    def failLastRead(self):
+        for i in reversed(range(len(self.TestOps))):
+            fields = self.TestOps[i].split(":")
+            if (fields[1] == OpAction.Read.value and len(fields) == 4):
+                fields[2] = str(int(fields[2]) ^ 1)
+                self.TestOps[i] = ":".join(fields)
+                return
+
     def getTest(self):
         return(self.TestOps)
 
@@ -474,16 +599,61 @@ class Test:
         for op in self.TestOps:
             print(op)
 
-
-def run_direct(subName, verbosity, verbosityMask, vpi, testFile, numCycles):
+    # Counter after a fast-forward left it at ffCount with reset released; the
+    # model is clocked before the test ops of every tick, so tick i sees
+    # ffCount+1+i. Every other read expects a miss to catch a wrong count
+    def buildCounterFastForwardTest(self, numCycles, ffCount):
+        for i in range(0, numCycles):
+            ctr = (ffCount + 1 + i) % 8
+            if (i > 0):
+                self.addTestOp("done", OpAction.Read, int(i % 2 == 1), i)
+            # stop is compared with the count at the next tick
+            nextCtr = (ctr + 1) % 8
+            self.addTestOp("stop", OpAction.Write, nextCtr if i % 2 == 0 else (nextCtr + 4) % 8, i)
+
+    # Counter with idleCycles and busyPort done: reset holds the count at 0 and
+    # done=1 keeps the model awake until busyTicks, then the model idles on
+    # done=0 until reset is released at busyTicks+idleTicks. The counts after
+    # the wake only match if the skipped cycles were accounted for
+    def buildCounterIdleTest(self, numCycles, busyTicks=16, idleTicks=24):
+        self.addTestOp("reset_l", OpAction.Write, 0, 0)
+        self.addTestOp("stop", OpAction.Write, 0, 0)
+        for i in range(2, busyTicks, 4):
+            self.addTestOp("done", OpAction.Read, 1, i)
+        self.addTestOp("stop", OpAction.Write, 1, busyTicks)
+        wake = busyTicks + idleTicks
+        for i in range(busyTicks + 1, wake, 4):
+            self.addTestOp("done", OpAction.Read, 0, i)
+        self.addTestOp("reset_l", OpAction.Write, 1, wake)
+        for i in range(wake, numCycles):
+            if (i > wake):
+                self.addTestOp("done", OpAction.Read, int((i - wake) % 2 == 1), i)
+            # tick i sees the count i-wake; stop is compared at the next tick
+            nextCtr = (i + 1 - wake) % 8
+            self.addTestOp("stop", OpAction.Write, nextCtr if (i - wake) % 2 == 0 else (nextCtr + 4) % 8, i)
+
+def run_direct(subName, verbosity, verbosityMask, vpi, testFile, numCycles, pfx="", quantum=1, snapshotSave="", snapshotRestore="", bench=False, variant="", probes=False, rows=False, changes=False, memImage="", fastForward=0, fastForwardUntil=False, trace="", recorder="", recorderAt="finish", idle=False):
     testScheme = Test()
     # tell Test to ignore clk writes
     testScheme.setDirectMode()
-    if ( subName == "Counter" ):
+    if ( subName == "Counter" and fastForward ):
+        # fast-forward cycle 0 holds reset and every later cycle counts; with
+        # the trigger, it stops as soon as the count reaches stop (5)
+        ffStop = 5 if fastForwardUntil else 0
+        ffStimulus = tempfile.NamedTemporaryFile("w", prefix=f"{pfx}Counter-ff-", suffix=".stim", delete=False)
+        ffStimulus.write(f"0 reset_l 0\n0 stop {ffStop}\n1 reset_l 1\n")
+        ffStimulus.close()
+        ffCount = ffStop if fastForwardUntil else (fastForward - 1) % 8
+        testScheme.buildCounterFastForwardTest(numCycles, ffCount)
+        print(f"Fast-forward test for Counter from count {ffCount}:")
+    elif ( subName == "Counter" and idle ):
+        testScheme.buildCounterIdleTest(numCycles)
+        print("Idle test for Counter:")
+    elif ( subName == "Counter" ):
         testScheme.buildCounterTest(numCycles, 1)
         print("Basic test for Counter:")
     elif ( subName == "Accum" ):
-        testScheme.buildAccumTest(numCycles)
+        testScheme.buildAccumTest(numCycles, probes, rows, changes)
         print("Basic test for Accum:")
     elif ( subName == "Accum1D" ):
         testScheme.buildAccum1DTest(numCycles)
@@ -491,6 +661,11 @@ def run_direct(subName, verbosity, verbosityMask, vpi, testFile, numCycles):
     elif ( subName == "UART" ):
         testScheme.buildUartTest(numCycles)
         print("Basic test for UART:")
+    elif ( subName == "Scratchpad" and memImage ):
+        # one byte per RAM row
+        image, memPort = writeMemImage(memImage, os.urandom(SCRATCH_SIZE))
+        testScheme.buildScratchImageTest(numCycles, image)
+        print("Image test for Scratchpad:")
     elif ( subName == "Scratchpad" ):
         testScheme.buildScratchTest(numCycles)
         print("Basic test for Scratchpad:")
@@ -501,26 +676,72 @@ def run_direct(subName, verbosity, verbosityMask, vpi, testFile, numCycles):
         testScheme.buildPicoTest(numCycles)
         print("Basic test for PicoRV:")
 
+    if ( recorder and recorderAt == "exit" ):
+        # fail the last read so that the fatal error leaves an exit dump
+        testScheme.failLastRead()
+
     print(testScheme)
-    top = sst.Component("top0", "verilatortestdirect.VerilatorTestDirect")
+    top = sst.Component(f"{pfx}top0", "verilatortestdirect.VerilatorTestDirect")
     top.addParams({
         "verbose" : verbosity,
         "verboseMask" : verbosityMask,
         "clockFreq" : "1GHz",
         "testFile" : testFile,
         "testOps" : testScheme.getTest(),
-        "numCycles" : numCycles
+        "numCycles" : numCycles,
+        "benchReport" : int(bench),
+        "checkTicks" : int(idle)
     })
-    print(f"Running direct test for {subName}Direct")
-    fullName = f"verilatorsst{subName}Direct.VerilatorSST{subName}"
+    print(f"Running direct test for {subName}{variant}Direct")
+    fullName = f"verilatorsst{subName}{variant}Direct.VerilatorSST{subName}{variant}"
     model = top.setSubComponent("model", f"{fullName}Direct")
     model.addParams({
         "useVPI" : vpi,
         "clockFreq" : "1GHz",
         "clockPort" : "clk",
+        "quantum" : quantum,
+        "snapshotSave" : snapshotSave,
+        "snapshotRestore" : snapshotRestore,
     })
-
-def run_links(subName, verbosity, verbosityMask, vpi, testFile, numCycles):
+    if memImage:
+        # the RAM is reached through the "mem" probe of ScratchpadDirect
+        model.addParams({
+            "memInit" : [f"{memPort}:{memImage}"],
+            "memDump" : [f"mem:{memImage}.dump"],
+        })
+    if trace:
+        # traceStart and traceStop are model ticks, two per cycle
+        model.addParams({
+            "traceFile" : trace,
+            "traceStart" : TRACE_START,
+            "traceStop" : TRACE_STOP,
+        })
+    if recorder:
+        model.addParams({
+            "recorderEntries" : RECORDER_ENTRIES,
+            "recorderBytes" : 8,
+            "recorderFile" : recorder,
+            "recorderAtFinish" : recorderAt == "finish",
+        })
+        if recorderAt == "trigger":
+            model.addParams({"recorderTrigger" : "done:1"})
+    # a restored snapshot of a fast-forwarded run already holds the count
+    if ( subName == "Counter" and fastForward and not snapshotRestore ):
+        model.addParams({
+            "fastForwardCycles" : fastForward,
+            "fastForwardStimulus" : ffStimulus.name,
+        })
+        if fastForwardUntil:
+            model.addParams({"fastForwardUntil" : "done:1"})
+    if idle:
+        # verbose 2 reports each idle and wake for test/CMakeLists.txt
+        model.addParams({
+            "idleCycles" : 4,
+            "busyPort" : "done",
+            "verbose" : 2,
+        })
+
+def run_links(subName, verbosity, verbosityMask, vpi, testFile, numCycles, pfx="", bus=False, forkTick=0, forkVariants=0, forkSummary="", bench=False, subscribe=False, rows=False, changes=False):
     testScheme = Test()
     ports = PortDef()
     if ( subName == "Counter" ):
@@ -535,10 +756,10 @@ def run_links(subName, verbosity, verbosityMask, vpi, testFile, numCycles):
         ports.addPort("clk",     1,  WRITE_PORT)
         ports.addPort("reset_l", 1,  WRITE_PORT)
         ports.addPort("en",      1,  WRITE_PORT)
-        ports.addPort("add",     8,  WRITE_PORT)
-        ports.addPort("accum",   16, READ_PORT)
+        ports.addPort("add",     8,  WRITE_PORT, 4)
+        ports.addPort("accum",   16, READ_PORT, 4)
         ports.addPort("done",    1,  READ_PORT)
-        testScheme.buildAccumTest(numCycles)
+        testScheme.buildAccumTest(numCycles, rows=rows, changes=changes)
         print(ports.getPortMap())
         print("Basic test for Accum:")
     elif ( subName == "Accum1D" ):
@@ -612,9 +833,29 @@ def run_links(subName, verbosity, verbosityMask, vpi, testFile, numCycles):
         testScheme.buildPicoTest(numCycles)
         print(ports.getPortMap())
         print("Basic test for PicoRV:")
+    if ( subName == "Counter" and subscribe ):
+        # done is pushed on change for the first two thirds of the run
+        testScheme.addSubscription("done", numCycles * 2 // 3)
+        print("Subscribing to done:")
     print(testScheme)
 
-    tester = sst.Component("vtestLink0", "verilatortestlink.VerilatorTestLink")
+    # each forked child applies the ops from forkTick on from its own file and
+    # writes its outputs to forkDir/fork<i>; Counter children each count to a
+    # different stop value, other models replay the remaining ops
+    forkFiles = [ ]
+    forkDir = ""
+    if forkTick > 0:
+        forkDir = tempfile.mkdtemp(prefix=f"{pfx}{subName}-fork-")
+        forkOps = [ op for op in testScheme.getTest() if int(op.split(":")[-1]) >= forkTick ]
+        for i in range(forkVariants):
+            ops = forkOps
+            if ( subName == "Counter" ):
+                ops = counterForkVariant(forkOps, forkTick, (6 - i) % 8)
+            forkFiles.append(os.path.join(forkDir, f"variant{i}.txt"))
+            with open(forkFiles[i], "w") as f:
+                f.write("\n".join(ops) + "\n")
+
+    tester = sst.Component(f"{pfx}vtestLink0", "verilatortestlink.VerilatorTestLink")
     tester.addParams({
         "verbose" : verbosity,
         "verboseMask" : verbosityMask,
@@ -623,11 +864,17 @@ def run_links(subName, verbosity, verbosityMask, vpi, testFile, numCycles):
         "portMap" : ports.getPortMap(),
         "testFile" : testFile,
         "testOps" : testScheme.getTest(),
-        "numCycles" : numCycles
+        "numCycles" : numCycles,
+        "useBus" : int(bus),
+        "forkTick" : forkTick,
+        "forkTestFiles" : forkFiles,
+        "forkSummary" : forkSummary,
+        "forkOutputDir" : forkDir,
+        "benchReport" : int(bench)
     })
 
     # VerilatorComponent just holds the subcomponent
-    verilatorsst = sst.Component("vsst", "verilatorcomponent.VerilatorComponent")
+    verilatorsst = sst.Component(f"{pfx}vsst", "verilatorcomponent.VerilatorComponent")
     verilatorsst.addParams({
         "numCycles" : numCycles
     })
@@ -640,30 +887,55 @@ def run_links(subName, verbosity, verbosityMask, vpi, testFile, numCycles):
         "clockPort" : "clk"
     })
 
+    if bus:
+        # a single link carries batched reads/writes for every port
+        busLink = sst.Link( f"{pfx}bus" )
+        busLink.connect( ( model, "bus", "0ps" ), ( tester, "bus", "0ps" ) )
+        return
+
     Links = [ ]
     # connect each verilator subcomponent port with a VerilatorTestLink port
     for i in range(ports.getNumPorts()):
-        Links.append( sst.Link( f"link{i}" ) )
+        Links.append( sst.Link( f"{pfx}link{i}" ) )
         Links[i].connect( ( model, ports.getPortName( i ), "0ps" ), ( tester, f"port{i}", "0ps" ) )
 
 def main():
 
     examples = ["Counter", "Accum", "Accum1D", "UART", "Scratchpad", "Pin", "PicoRV"]
     parser = argparse.ArgumentParser(description="Sample script to run verilator SST examples")
-    parser.add_argument("-m", "--model", choices=examples, default="Accum", help=("Select model from examples: "+str(examples)))
+    parser.add_argument("-m", "--model", choices=examples, nargs="+", default=["Accum"], help=("Select one or more models from examples: "+str(examples)+"; multiple models share one SST process"))
     parser.add_argument("-i", "--interface", choices=["links", "direct"], default="links", help="Select the direct testing method or the SST::Link method")
-    parser.add_argument("-v", "--verbose", choices=range(15), default=4, help="Set the level of verbosity used by the test components")
+    parser.add_argument("-v", "--verbose", type=int, choices=range(15), default=4, help="Set the level of verbosity used by the test components")
     parser.add_argument("-a", "--access", choices=["vpi", "direct"], default="direct", help="Select the method used by the subcomponent to read/write the verilated model's ports")
     parser.add_argument("-k", "--mask", choices=[choice.name for choice in VerboseMasking], default="FULL")
     parser.add_argument("-c", "--cycles", default=50, help="Set number of cycles the simulation will run for")
     parser.add_argument("-t", "--testfile", default="", help="Absolute path of file to load TestOps from")
+    parser.add_argument("-b", "--bus", action="store_true", help="Drive the links interface through batched events on a single bus link")
+    parser.add_argument("-q", "--quantum", type=int, default=1, help="Model cycles run per subcomponent clock callback (direct interface)")
+    parser.add_argument("--subscribe", action="store_true", help="Subscribe to the Counter done port and check every pushed value against the reads (links interface)")
+    parser.add_argument("--fork-tick", type=int, default=0, help="Fork the links simulation at this tick (links interface)")
+    parser.add_argument("--fork-variants", type=int, default=2, help="Number of children forked at --fork-tick, each replaying the remaining ops")
+    parser.add_argument("--fork-summary", default="", help="File the forking parent writes the per-child results to")
+    parser.add_argument("--snapshot-save", default="", help="Save a model snapshot after setup (direct interface, SAVABLE models)")
+    parser.add_argument("--snapshot-restore", default="", help="Restore a model snapshot in setup (direct interface, SAVABLE models)")
+    parser.add_argument("--probes", action="store_true", help="Also check the internal registers through probe points (Accum, direct interface)")
+    parser.add_argument("--rows", action="store_true", help="Also drive the Accum add and accum arrays through row range accesses (direct and links interfaces)")
+    parser.add_argument("--changes", action="store_true", help="Also read the Accum accum array through changed row reads (direct interface, or links without --bus)")
+    parser.add_argument("--mem-image", default="", help="Preload the Scratchpad RAM from a random image written to this file (.hex, .elf or raw) and dump it to FILE.dump at finish; FILE.expected holds the RAM contents to compare against (direct interface)")
+    parser.add_argument("--fast-forward", type=int, default=0, help="Fast-forward Counter this many cycles in setup, then check the counts that follow; with --snapshot-restore the count comes from the snapshot instead (direct interface)")
+    parser.add_argument("--fast-forward-until", action="store_true", help="End the Counter fast-forward early once done matches (direct interface)")
+    parser.add_argument("--trace", default="", help=f"Write an FST trace of ticks {TRACE_START} to {TRACE_STOP} to this file (direct interface, TRACE builds)")
+    parser.add_argument("--recorder", default="", help=f"Keep a {RECORDER_ENTRIES} entry flight recorder dumped to this file (direct interface)")
+    parser.add_argument("--recorder-at", choices=["finish", "trigger", "exit"], default="finish", help="Dump the flight recorder at finish, when done is first 1, or at exit after the last read is made to fail")
+    parser.add_argument("--idle", action="store_true", help="Let Counter idle between a busy and a counting phase and check the counts after it wakes (direct interface)")
+    parser.add_argument("--variant", default="", help="Build variant suffix of the device, e.g. NoVPI for PicoRVNoVPIDirect (direct interface)")
+    parser.add_argument("--bench", action="store_true", help="Print a BENCH line with the run time, ops and allocations at finish (test/bench/sst-bench.py)")
 
     args = parser.parse_args()
 
-    if args.model not in examples:
-        raise Exception("Unknown model selected")
-
-    sub = args.model
+    for sub in args.model:
+        if sub not in examples:
+            raise Exception("Unknown model selected")
     numCycles = int(args.cycles)
     chosenMask = args.mask
     verbosityMask = VerboseMasking[chosenMask].value
@@ -676,10 +948,17 @@ def main():
         vpi = 0
 
 
-    if args.interface == "direct":
-        run_direct(sub, verbosity, verbosityMask, vpi, testFile, numCycles)
-    elif args.interface == "links":
-        run_links(sub, verbosity, verbosityMask, vpi, testFile, numCycles)
+    # additional models get a unique prefix on their component and link names
+    for idx, sub in enumerate(args.model):
+        pfx = "" if idx == 0 else f"m{idx}_"
+        if args.interface == "direct":
+            run_direct(sub, verbosity, verbosityMask, vpi, testFile, numCycles, pfx, args.quantum,
+                       args.snapshot_save, args.snapshot_restore, args.bench, args.variant, args.probes, args.rows,
+                       args.changes, args.mem_image, args.fast_forward, args.fast_forward_until,
+                       args.trace, args.recorder, args.recorder_at, args.idle)
+        elif args.interface == "links":
+            run_links(sub, verbosity, verbosityMask, vpi, testFile, numCycles, pfx, args.bus,
+                      args.fork_tick, args.fork_variants, args.fork_summary, args.bench, args.subscribe, args.rows, args.changes)
           
     sst.setStatisticLoadLevel(7)
     sst.setStatisticOutput("sst.statOutputCSV")
@@ -33,6 +33,8 @@ VerilatorTestDirect::VerilatorTestDirect(SST::ComponentId_t id,
   InitTestOps( params );
 
   NumCycles = params.find<uint64_t>("numCycles", 1000);
+  BenchReport = params.find<bool>("benchReport", false);
+  CheckTicks = params.find<bool>("checkTicks", false);
 
   registerAsPrimaryComponent();
   primaryComponentDoNotEndSim();
@@ -44,9 +46,22 @@ VerilatorTestDirect::~VerilatorTestDirect(){
 }
 
 void VerilatorTestDirect::setup(){
+  if ( model ) {
+    model->setup();
+  }
+  if( BenchReport ){
+    Bench.start();
+  }
 }
 
 void VerilatorTestDirect::finish(){
+  // the model's finish (dumps, reports) is not part of the measured run
+  if( BenchReport ){
+    Bench.report( output, currTick, OpsDone );
+  }
+  if ( model ) {
+    model->finish();
+  }
 }
 
 void VerilatorTestDirect::init( unsigned int phase ){
@@ -112,16 +127,20 @@ void VerilatorTestDirect::InitTestOps( const SST::Params& params ) {
 
 bool VerilatorTestDirect::ExecTestOp() {
   if ( !OpQueue.empty() ) {
-    const TestOp currOp = OpQueue.front();
-    const std::string portName = currOp.PortName;
+    const TestOp & currOp = OpQueue.front();
+    const std::string & portName = currOp.PortName;
+    const PortHandle port = currOp.Port;
     uint32_t width;
     uint32_t depth;
-    model->getPortWidth( portName, width );
-    model->getPortDepth( portName, depth );
+    model->getPortWidth( port, width );
+    model->getPortDepth( port, depth );
+    if ( currOp.RowCount ) {
+      depth = currOp.RowCount;
+    }
     const uint32_t byteWidth = width / 8 + ( ( width % 8 == 0 ) ? 0 : 1 );
     uint32_t size = byteWidth * depth;
     VPortType portType;
-    model->getPortType(portName, portType);
+    model->getPortType(port, portType);
     const bool writing = currOp.isWrite;
     const uint32_t nvals = size / 8;
     const uint64_t tick = currOp.AtTick; 
@@ -134,7 +153,8 @@ bool VerilatorTestDirect::ExecTestOp() {
     }
     // convert the given data to a byte vector
     const uint64_t * vals = currOp.Values;
-    std::vector<uint8_t> Data;
+    std::vector<uint8_t> & Data = OpData;
+    Data.clear();
     for ( size_t i=0; i<nvals; i++ ) {
       AddToPacket<uint64_t>( vals[i], Data );
       size -= 8;
@@ -159,14 +179,47 @@ bool VerilatorTestDirect::ExecTestOp() {
         output.verbose( CALL_INFO, 4, VerboseMasking::WRITE_DATA, "byte %zu: %" PRIx8 "\n", i, Data[i] );
       }
       // perform the write operation
-      model->writePort(portName, Data);
+      if ( currOp.RowCount ) {
+        model->writePortRows(port, currOp.FirstRow, currOp.RowCount, Data.data(), Data.size());
+      } else {
+        model->writePort(port, Data.data(), Data.size());
+      }
+      // the model runs two ticks per clock cycle, idle or not; a write wakes an idle
+      // model, so its tick must hold the same offset from the test tick at every write
+      if ( CheckTicks ) {
+        const uint64_t modelTick = model->getCurrentTick();
+        if ( !TickOffset ) {
+          TickOffset = modelTick - 2 * currTick;
+        } else if ( modelTick - 2 * currTick != *TickOffset ) {
+          output.fatal(CALL_INFO, -1,
+                       "Error: model tick %" PRIu64 " is out of step with test tick %" PRIu64 " (offset %" PRId64 ", should be %" PRId64 ")\n",
+                       modelTick, currTick, static_cast<int64_t>(modelTick - 2 * currTick), static_cast<int64_t>(*TickOffset) );
+        }
+      }
     } else {
       output.verbose( CALL_INFO, 4, VerboseMasking::READ_EVENT, "Sending read on port %s: data to be checked has size=%zu\n", portName.c_str(), Data.size() );
       for (size_t i=0; i<Data.size(); i++) {
         output.verbose( CALL_INFO, 4, VerboseMasking::READ_DATA, "byte %zu: %" PRIx8 "\n", i, Data[i] );
       }
       // perform the read operation and compare read data to expected read data
-      const std::vector<uint8_t> & ReadData = model->readPort(portName);
+      std::vector<uint8_t> & ReadData = ReadBuf;
+      if ( currOp.isChanges ) {
+        // apply the changed rows to the mirror of the port and check the whole mirror
+        std::vector<uint8_t> & Mirror = Mirrors[port];
+        Mirror.resize( model->getPortBytes(port) );
+        const size_t changed = model->readPortChanges(port, ChangedRows, ReadData);
+        output.verbose( CALL_INFO, 4, VerboseMasking::READ_DATA, "Changed rows: %zu\n", changed );
+        for (size_t i=0; i<changed; i++) {
+          std::copy( &ReadData[i*byteWidth], &ReadData[(i+1)*byteWidth], &Mirror[ChangedRows[i]*byteWidth] );
+        }
+        ReadData = Mirror;
+      } else if ( currOp.RowCount ) {
+        ReadData.resize( byteWidth * currOp.RowCount );
+        model->readPortRowsInto(port, currOp.FirstRow, currOp.RowCount, ReadData.data(), ReadData.size());
+      } else {
+        ReadData.resize( model->getPortBytes(port) );
+        model->readPortInto(port, ReadData.data(), ReadData.size());
+      }
       output.verbose( CALL_INFO, 4, VerboseMasking::READ_DATA, "Read data: size=%zu\n", ReadData.size() );
       for (size_t i=0; i<ReadData.size(); i++) {
         output.verbose( CALL_INFO, 4, VerboseMasking::READ_DATA, "byte %zu: %" PRIx8 "\n", i, ReadData[i] );
@@ -185,6 +238,7 @@ bool VerilatorTestDirect::ExecTestOp() {
       }
     }
     OpQueue.pop();
+    OpsDone++;
   return true;
   }
   return false;
@@ -213,7 +267,7 @@ void VerilatorTestDirect::splitStr(const std::string& s,
 
 bool VerilatorTestDirect::clock(SST::Cycle_t currentCycle){
   output.verbose( CALL_INFO, 4, VerboseMasking::CLOCK_INFO, "Clocking cycle %" PRIu64 "\n", currentCycle );
-  if( currentCycle > NumCycles ){
+  if( currentCycle > NumCycles || model->isFinished() ){
     primaryComponentOKToEndSim();
     return true;
   }
@@ -13,7 +13,9 @@
 
 // -- Standard Headers
 #include <list>
+#include <map>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <random>
 #include <stdio.h>
@@ -30,21 +32,31 @@
 // -- Verilator SST Headers
 #include "verilatorSSTSubcomponent.h"
 
+// -- Test Headers
+#include "BenchRun.h"
+
 namespace SST::VerilatorSST {
 
 // struct to hold info defining each operation to be performed for testing
 struct TestOp {
   std::string PortName;
+  PortHandle Port;
   uint64_t * Values; // Either write data or expected read data
   uint64_t AtTick;
   bool isWrite;
+  unsigned FirstRow; // first row of a row range op
+  unsigned RowCount; // rows of a row range op; 0 for the whole port
+  bool isChanges; // read through readPortChanges; Values hold the expected whole port
 
   // Default constructor
-  TestOp() : PortName( 0 ), isWrite(false), Values( nullptr ), AtTick( 0 ) { }
+  TestOp() : PortName( 0 ), Port( 0 ), isWrite(false), Values( nullptr ), AtTick( 0 ), FirstRow( 0 ), RowCount( 0 ),
+             isChanges( false ) { }
 
   // Full constructor
-  TestOp( const std::string PortName, bool isWrite, uint64_t * Values, uint64_t AtTick ) : 
-          PortName( PortName ), isWrite(isWrite), Values( Values ), AtTick( AtTick ) { }
+  TestOp( const std::string PortName, PortHandle Port, bool isWrite, uint64_t * Values, uint64_t AtTick,
+          unsigned FirstRow = 0, unsigned RowCount = 0 ) :
+          PortName( PortName ), Port( Port ), isWrite(isWrite), Values( Values ), AtTick( AtTick ),
+          FirstRow( FirstRow ), RowCount( RowCount ), isChanges( false ) { }
 };
 
 class VerilatorTestDirect : public SST::Component {
@@ -86,9 +98,25 @@ public:
     uint32_t width;
     uint32_t depth;
     const bool isWrite = strcmp(op[1].c_str(), "write") == 0;
-    model->getPortWidth(op[0], width); // in bits
+    // "name[first-last]" addresses rows first..last of an array port
+    std::string name = op[0];
+    unsigned firstRow = 0;
+    unsigned rowCount = 0;
+    const std::string::size_type bracket = name.find('[');
+    if ( bracket != std::string::npos ) {
+      std::vector<std::string> rows;
+      splitStr( name.substr( bracket+1, name.size()-bracket-2 ), '-', rows );
+      firstRow = std::stoul( rows.front() );
+      rowCount = std::stoul( rows.back() ) + 1 - firstRow;
+      name = name.substr( 0, bracket );
+    }
+    const PortHandle port = model->resolvePort(name);
+    model->getPortWidth(port, width); // in bits
     const uint32_t byteWidth = ( width / 8 ) + ( ( width % 8 == 0 ) ? 0 : 1 );
-    model->getPortDepth(op[0], depth);
+    model->getPortDepth(port, depth);
+    if ( rowCount ) {
+      depth = rowCount;
+    }
     uint32_t size = byteWidth * depth;
     uint32_t nvals = size / 8;
     const  uint32_t rem = (size % 8 == 0) ? 0 : 1;
@@ -104,7 +132,8 @@ public:
       nvals++;
     }
     const uint64_t tick = std::stoull( op[2+nvals] );
-    const TestOp toRet( op[0], isWrite, values, tick );
+    TestOp toRet( op[0], port, isWrite, values, tick, firstRow, rowCount );
+    toRet.isChanges = strcmp(op[1].c_str(), "changes") == 0;
     return toRet;
   }
 
@@ -130,6 +159,8 @@ public:
     {"testFile",    "name of file holding test ops", ""},
     {"testOps",     "List of 'portname:vals:tick' strings to drive testing", ""},
     {"numCycles",   "Number of cycles to exec", "1000"},
+    {"benchReport", "Print a BENCH line with the run time, ops and allocations at finish", "0"},
+    {"checkTicks",  "Check after every write that the model tick keeps step with the test tick", "0"},
   )
 
   // -------------------------------------------------------
@@ -149,7 +180,16 @@ private:
   uint64_t NumCycles;                             ///< VerilatorTestDirect: number of cycles to execute
   SST::VerilatorSST::VerilatorSSTBase *model;     ///< VerilatorTestDirect: subcomponent model
   std::queue<TestOp> OpQueue;                     ///< VerilatorTestDirect: queue holding test operations in order of tick
+  std::vector<uint8_t> OpData;                    ///< VerilatorTestDirect: reusable buffer for the data of a test op
+  std::vector<uint8_t> ReadBuf;                   ///< VerilatorTestDirect: reusable buffer for port reads
+  std::map<PortHandle, std::vector<uint8_t>> Mirrors; ///< VerilatorTestDirect: port values rebuilt from changes ops
+  std::vector<uint32_t> ChangedRows;              ///< VerilatorTestDirect: reusable readPortChanges rows
   uint64_t currTick = 0;         ///< VerilatorTestDirect: current tick of the test component
+  bool BenchReport = false;      ///< VerilatorTestDirect: print the BENCH line at finish
+  bool CheckTicks = false;       ///< VerilatorTestDirect: check the model tick at every write
+  std::optional<uint64_t> TickOffset; ///< VerilatorTestDirect: model tick minus twice the test tick at the first write
+  uint64_t OpsDone = 0;          ///< VerilatorTestDirect: test operations executed
+  BenchRun Bench;                ///< VerilatorTestDirect: host time and allocations of the measured run
 
   void InitTestOps( const SST::Params& params ); ///<VerilatorTestDirect: load test operations from component params
   bool ExecTestOp();                             ///<VerilatorTestDirect: execute a test operation if there are any for the current tick
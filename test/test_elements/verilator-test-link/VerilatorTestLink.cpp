@@ -10,7 +10,17 @@
 
 #include "verilatorSSTAPI.h"
 #include "VerilatorTestLink.h"
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
 #include <fstream>
+#include <limits>
+#include <set>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 namespace SST::VerilatorSST{
 
@@ -34,6 +44,10 @@ VerilatorTestLink::VerilatorTestLink(SST::ComponentId_t id,
   const int NumPorts = params.find<int>( "num_ports", 0 );
   InfoVec.resize( NumPorts );
   ExpectedReadData.resize( NumPorts );
+  ExpectedRows.resize( NumPorts );
+  Subscribed.resize( NumPorts, false );
+  SubInterval.resize( NumPorts, 0 );
+  SubValues.resize( NumPorts );
   InitLinkConfig( params );
   InitPortMap( params );
   InitTestOps( params );
@@ -44,6 +58,23 @@ VerilatorTestLink::VerilatorTestLink(SST::ComponentId_t id,
 
   NumCycles = params.find<uint64_t>( "numCycles", 1000 );
 
+  ForkTick = params.find<uint64_t>( "forkTick", 0 );
+  params.find_array<std::string>( "forkTestFiles", ForkTestFiles );
+  ForkSummary = params.find<std::string>( "forkSummary", "" );
+  ForkOutputDir = params.find<std::string>( "forkOutputDir", "." );
+  BenchReport = params.find<bool>( "benchReport", false );
+  if( ForkTick && ForkTestFiles.empty() ){
+    output.fatal( CALL_INFO, -1, "Error: forkTick is set but forkTestFiles is empty\n" );
+  }
+  // fork() copies only the calling thread, and other ranks would not follow
+  if( ForkTick ){
+    const SST::RankInfo Ranks = getNumRanks();
+    if( Ranks.rank != 1 || Ranks.thread != 1 ){
+      output.fatal( CALL_INFO, -1, "Error: forkTick requires a serial run (%" PRIu32 " ranks, %" PRIu32 " threads)\n",
+                    Ranks.rank, Ranks.thread );
+    }
+  }
+
   if( primaryComponent) {
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
@@ -54,12 +85,40 @@ VerilatorTestLink::VerilatorTestLink(SST::ComponentId_t id,
 
 VerilatorTestLink::~VerilatorTestLink(){
   delete [] Links;
+  delete Batch;
 }
 
 void VerilatorTestLink::setup(){
+  if( model ){
+    model->setup();
+  }
+  if( BusLink ){
+    for( const auto& [name, info] : PortMap ){
+      if( BusHandles[info.PortId] == std::numeric_limits<PortHandle>::max() ){
+        output.fatal( CALL_INFO, -1, "Error: port %s was not found in the bus port directory\n", name.c_str() );
+      }
+    }
+  }
+  if( BenchReport ){
+    Bench.start();
+  }
 }
 
 void VerilatorTestLink::finish(){
+  // the model's finish (dumps, reports) is not part of the measured run
+  if( BenchReport ){
+    Bench.report( output, currTick, OpsDone );
+  }
+  if( model ){
+    model->finish();
+  }
+  if( !ForkPids.empty() ){
+    WaitChildren();
+  }
+  // each subscription answers with the current value; anything beyond that was pushed
+  if( SubscribeOps && Notifications <= SubscribeOps ){
+    output.fatal( CALL_INFO, -1, "Error: %" PRIu64 " subscriptions received no value notifications\n", SubscribeOps );
+  }
 }
 
 void VerilatorTestLink::init( unsigned int phase ){
@@ -67,6 +126,25 @@ void VerilatorTestLink::init( unsigned int phase ){
     output.verbose( CALL_INFO, 1, VerboseMasking::INIT, "Initializing the Verilator model\n");
     model->init(phase);
   }
+  // map the port IDs onto the handles published by the subcomponent
+  while( BusLink ){
+    SST::Event * ev = BusLink->recvUntimedData();
+    if( !ev ){
+      break;
+    }
+    const PortBatchEvent * dir = dynamic_cast<const PortBatchEvent *>( ev );
+    if( dir ){
+      const std::vector<std::string>& names = dir->getNames();
+      for( PortHandle handle = 0; handle < names.size(); handle++ ){
+        const auto it = PortMap.find( names[handle] );
+        if( it != PortMap.end() ){
+          BusHandles[it->second.PortId] = handle;
+          BusPortIds[handle] = it->second.PortId;
+        }
+      }
+    }
+    delete ev;
+  }
 }
 
 void VerilatorTestLink::InitPortMap( const SST::Params& params ) {
@@ -78,7 +156,7 @@ void VerilatorTestLink::InitPortMap( const SST::Params& params ) {
     std::vector<std::string> vstr;
     const std::string s = optList[i];
     splitStr(s, ':', vstr);
-    if( vstr.size() != 4 ){
+    if( vstr.size() != 4 && vstr.size() != 5 ){
       output.fatal(CALL_INFO, -1,
                     "Error in reading value from portMap parameter:%s\n",
                     s.c_str() );
@@ -87,20 +165,34 @@ void VerilatorTestLink::InitPortMap( const SST::Params& params ) {
     const long unsigned portId = std::stoul( vstr[1] );
     const long unsigned portSize = std::stoul( vstr[2] );
     const long unsigned portType = std::stoul( vstr[3] );
+    const long unsigned portDepth = vstr.size() == 5 ? std::stoul( vstr[4] ) : 1;
+    if( portDepth == 0 || portSize % portDepth != 0 ){
+      output.fatal(CALL_INFO, -1, "Error: port %s size %lu is not a whole number of %lu rows\n",
+                    vstr[0].c_str(), portSize, portDepth );
+    }
     const bool portIsWriteable = (static_cast<uint8_t>(portType) & static_cast<uint8_t>(VPortType::V_INPUT)) > 0;
     const bool portIsReadable = (static_cast<uint8_t>(portType) & static_cast<uint8_t>(VPortType::V_OUTPUT)) > 0;
     // put the port info in the map and the info vector
-    PortMap[vstr[0]] = PortDef( portId, portSize, portIsWriteable, portIsReadable ); 
+    PortMap[vstr[0]] = PortDef( portId, portSize, portIsWriteable, portIsReadable, portDepth ); 
     InfoVec[portId].PortId = portId;
     InfoVec[portId].Size = portSize; 
     InfoVec[portId].Write = portIsWriteable;
     InfoVec[portId].Read = portIsReadable;
+    InfoVec[portId].Depth = portDepth;
   }
 }
 
 void VerilatorTestLink::InitLinkConfig( const SST::Params& params ) {
   const int NumPorts = params.find<int>( "num_ports", 0 );
-  if ( NumPorts > 0 ) {
+  if ( NumPorts > 0 && params.find<bool>( "useBus", false ) ) {
+    // all ports are reached through the single bus link
+    Links = nullptr;
+    BusHandles.resize( NumPorts, std::numeric_limits<PortHandle>::max() );
+    BusLink = configureLink( "bus", "0ns", new Event::Handler<VerilatorTestLink>( this, &VerilatorTestLink::RecvBatchEvent ) );
+    if ( BusLink == nullptr ) {
+      output.fatal( CALL_INFO, -1, "Error: Link for port bus failed to be configured\n" );
+    }
+  } else if ( NumPorts > 0 ) {
     Links = new SST::Link *[NumPorts];
     // configure a link for each port
     for (size_t i=0; i<NumPorts; i++) {
@@ -129,19 +221,143 @@ void VerilatorTestLink::InitTestOps( const SST::Params& params ) {
       OpQueue.push( toQueue );
     } 
   } else {
-    output.verbose( CALL_INFO, 4, VerboseMasking::INIT, "Loading test ops from file: %s\n", fileName.c_str() );
-    // load test operations from given file 
-    std::ifstream testFile( fileName );
-    std::string line;
-    if ( testFile.is_open() ) {
-      while ( std::getline( testFile, line) ) {
-        const TestOp & toQueue = ConvertToTestOp( line );
-        OpQueue.push( toQueue );
+    LoadTestFile( fileName );
+  }
+}
+
+void VerilatorTestLink::LoadTestFile( const std::string& fileName ) {
+  output.verbose( CALL_INFO, 4, VerboseMasking::INIT, "Loading test ops from file: %s\n", fileName.c_str() );
+  // load test operations from given file
+  std::ifstream testFile( fileName );
+  std::string line;
+  if ( testFile.is_open() ) {
+    while ( std::getline( testFile, line) ) {
+      const TestOp & toQueue = ConvertToTestOp( line );
+      OpQueue.push( toQueue );
+    }
+  } else {
+    output.fatal( CALL_INFO, -1, "Error: test file %s cannot be read\n", fileName.c_str() );
+  }
+}
+
+void VerilatorTestLink::ForkChildren() {
+  // each child shares the simulated prefix copy-on-write and replaces the
+  // remaining test operations with its own test file; the parent carries on
+  // with its own operations and collects the children in finish
+  for( size_t i = 0; i < ForkTestFiles.size(); i++ ){
+    fflush( stdout );
+    fflush( stderr );
+    const pid_t pid = fork();
+    if( pid < 0 ){
+      output.fatal( CALL_INFO, -1, "Error: fork failed for test file %s\n", ForkTestFiles[i].c_str() );
+    }
+    if( pid == 0 ){
+      ForkPids.clear();
+      const std::string Dir = ForkOutputDir + "/fork" + std::to_string( i );
+      if( mkdir( Dir.c_str(), 0755 ) != 0 && errno != EEXIST ){
+        output.fatal( CALL_INFO, -1, "Error: fork output directory %s cannot be created\n", Dir.c_str() );
       }
-    } else {
-      output.fatal( CALL_INFO, -1, "Error: test file %s cannot be read\n", fileName.c_str() );
+      SplitOpenFiles( Dir );
+      // outputs opened from now on with relative paths land in Dir
+      if( chdir( Dir.c_str() ) != 0 ){
+        output.fatal( CALL_INFO, -1, "Error: cannot change to fork output directory %s\n", Dir.c_str() );
+      }
+      OpQueue = std::queue<TestOp>();
+      LoadTestFile( ForkTestFiles[i] );
+      output.verbose( CALL_INFO, 1, VerboseMasking::INIT, "Forked child %zu running %s in %s\n",
+                      i, ForkTestFiles[i].c_str(), Dir.c_str() );
+      return;
+    }
+    ForkPids.push_back( pid );
+  }
+}
+
+void VerilatorTestLink::SplitOpenFiles( const std::string& Dir ) {
+  // files opened before the fork (statistics, traces) share their offset with
+  // the parent; the child continues in a copy of what was written so far
+  DIR* FdDir = opendir( "/proc/self/fd" );
+  if( !FdDir ){
+    output.fatal( CALL_INFO, -1, "Error: /proc/self/fd cannot be read\n" );
+  }
+  std::vector<int> Fds;
+  while( const dirent* Ent = readdir( FdDir ) ){
+    const int Fd = std::atoi( Ent->d_name );
+    if( Fd > 2 && Fd != dirfd( FdDir ) ){
+      Fds.push_back( Fd );
+    }
+  }
+  closedir( FdDir );
+
+  std::set<std::string> Names;
+  for( const int Fd : Fds ){
+    const int Flags = fcntl( Fd, F_GETFL );
+    struct stat St;
+    if( Flags < 0 || ( Flags & O_ACCMODE ) == O_RDONLY || fstat( Fd, &St ) != 0 ||
+        !S_ISREG( St.st_mode ) || St.st_nlink == 0 ){
+      continue;
+    }
+    const std::string Link = "/proc/self/fd/" + std::to_string( Fd );
+    char Target[4096];
+    const ssize_t Len = readlink( Link.c_str(), Target, sizeof( Target ) - 1 );
+    if( Len <= 0 ){
+      continue;
+    }
+    Target[Len] = '\0';
+    std::string Name = std::strrchr( Target, '/' ) ? std::strrchr( Target, '/' ) + 1 : Target;
+    if( !Names.insert( Name ).second ){
+      Name = std::to_string( Fd ) + "." + Name;
+    }
+    const std::string Copy = Dir + "/" + Name;
+
+    const int In = ::open( Link.c_str(), O_RDONLY );
+    const int Out = ::open( Copy.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    if( In < 0 || Out < 0 ){
+      output.fatal( CALL_INFO, -1, "Error: %s cannot be copied to %s\n", Target, Copy.c_str() );
+    }
+    off_t Done = 0;
+    while( Done < St.st_size ){
+      if( sendfile( Out, In, &Done, St.st_size - Done ) <= 0 ){
+        output.fatal( CALL_INFO, -1, "Error: %s cannot be copied to %s\n", Target, Copy.c_str() );
+      }
+    }
+    ::close( In );
+    const off_t Pos = lseek( Fd, 0, SEEK_CUR );
+    const int FdFlags = fcntl( Fd, F_GETFD );
+    lseek( Out, Pos, SEEK_SET );
+    fcntl( Out, F_SETFL, Flags & O_APPEND );
+    dup2( Out, Fd );
+    fcntl( Fd, F_SETFD, FdFlags );
+    ::close( Out );
+  }
+}
+
+void VerilatorTestLink::WaitChildren() {
+  std::ofstream summary;
+  if( !ForkSummary.empty() ){
+    summary.open( ForkSummary );
+    if( !summary.is_open() ){
+      output.fatal( CALL_INFO, -1, "Error: fork summary %s cannot be written\n", ForkSummary.c_str() );
+    }
+  }
+  unsigned failed = 0;
+  for( size_t i = 0; i < ForkPids.size(); i++ ){
+    int status = 0;
+    waitpid( ForkPids[i], &status, 0 );
+    const bool passed = WIFEXITED( status ) && WEXITSTATUS( status ) == 0;
+    const int code = WIFEXITED( status ) ? WEXITSTATUS( status ) : -WTERMSIG( status );
+    failed += !passed;
+    output.output( "fork child %zu %s: %s (status %d)\n", i, ForkTestFiles[i].c_str(),
+                   passed ? "PASS" : "FAIL", code );
+    if( summary.is_open() ){
+      summary << ForkTestFiles[i] << " " << ( passed ? "PASS" : "FAIL" ) << " " << code << "\n";
     }
   }
+  output.output( "fork fan-out: %zu children, %u failed\n", ForkPids.size(), failed );
+  summary.close();
+  if( failed ){
+    output.fatal( CALL_INFO, -1, "Error: %u of %zu forked children failed\n", failed, ForkPids.size() );
+  }
+  ForkPids.clear();
 }
 
 bool VerilatorTestLink::ExecTestOp() {
@@ -149,7 +365,7 @@ bool VerilatorTestLink::ExecTestOp() {
     const TestOp currOp = OpQueue.front();
     const uint32_t portId = currOp.PortId;
     const bool writing = currOp.isWrite;
-    uint32_t size = InfoVec[portId].Size;
+    uint32_t size = currOp.RowCount ? currOp.RowCount * ( InfoVec[portId].Size / InfoVec[portId].Depth ) : InfoVec[portId].Size;
     const uint32_t nvals = size / 8;
     const uint64_t tick = currOp.AtTick;
     // don't execute test op until desired cycle/tick
@@ -181,14 +397,54 @@ bool VerilatorTestLink::ExecTestOp() {
     if ( size > 0 ) {
       Data.push_back( *currPtr );
     }
-    if ( writing ) {
+    if ( currOp.isSubscribe || currOp.isUnsubscribe ) {
+      const PortEventAction action = currOp.isSubscribe ? PortEventAction::SUBSCRIBE : PortEventAction::UNSUBSCRIBE;
+      const uint64_t interval = currOp.isSubscribe ? vals[0] : 0;
+      output.verbose( CALL_INFO, 4, VerboseMasking::WRITE_EVENT, "Sending %s on port%" PRIu32 ": interval=%" PRIu64 "\n",
+                      currOp.isSubscribe ? "subscribe" : "unsubscribe", portId, interval );
+      // notifications are only accepted while subscribed
+      Subscribed[portId] = currOp.isSubscribe;
+      SubInterval[portId] = interval;
+      SubValues[portId].clear();
+      SubscribeOps += currOp.isSubscribe;
+      if ( BusLink ) {
+        if ( !Batch ) {
+          Batch = new PortBatchEvent();
+        }
+        Batch->addOp( BusHandles[portId], action, interval, 0 );
+      } else {
+        Links[portId]->send( new PortEvent( interval, action ) );
+      }
+    } else if ( currOp.isChanges ) {
+      // the changed rows come back as [uint32_t row][row bytes] pairs
+      if ( BusLink ) {
+        output.fatal(CALL_INFO, -1, "Error: changes ops need per-port links, not useBus\n" );
+      }
+      output.verbose( CALL_INFO, 4, VerboseMasking::READ_EVENT, "Sending changes on port%" PRIu32 "\n", portId );
+      ExpectedReadData[portId].emplace( Data );
+      ExpectedRows[portId].emplace( 0, 0 );
+      Links[portId]->send( new PortEvent( 0, PortEventAction::CHANGES ) );
+    } else if ( currOp.RowCount && BusLink ) {
+      output.fatal(CALL_INFO, -1, "Error: row range ops need per-port links, not useBus\n" );
+    } else if ( writing ) {
       output.verbose( CALL_INFO, 4, VerboseMasking::WRITE_EVENT, "Sending write on port%" PRIu32 ": size=%" PRIu32 "\n", portId, InfoVec[portId].Size );
       for (size_t i=0; i<Data.size(); i++) {
         output.verbose( CALL_INFO, 4, VerboseMasking::WRITE_DATA, "byte %zu: %" PRIx8 "\n", i, Data[i] );
       }
-      // create the write event and send it along the link
-      PortEvent * const opEvent = new PortEvent( Data );
-      Links[portId]->send( opEvent );
+      if ( BusLink ) {
+        // collect the write into this tick's batch
+        if ( !Batch ) {
+          Batch = new PortBatchEvent();
+        }
+        Batch->addWrite( BusHandles[portId], Data.data(), Data.size() );
+      } else {
+        // create the write event and send it along the link; a row range
+        // write carries only its rows
+        PortEvent * const opEvent = currOp.RowCount ?
+          new PortEvent( Data, 0, PortEventAction::WRITE, currOp.FirstRow, currOp.RowCount ) :
+          new PortEvent( Data );
+        Links[portId]->send( opEvent );
+      }
     } else {
       output.verbose( CALL_INFO, 4, VerboseMasking::READ_EVENT, "Sending read on port%" PRIu32 ": size=%zu, data to be checked:\n", portId, Data.size() );
       for (size_t i=0; i<Data.size(); i++) {
@@ -196,10 +452,21 @@ bool VerilatorTestLink::ExecTestOp() {
       }
       // store expected read data, create the read event, send it on the link
       ExpectedReadData[portId].emplace( Data );
-      PortEvent * const opEvent = new PortEvent();
-      Links[portId]->send( opEvent );
+      ExpectedRows[portId].emplace( currOp.FirstRow, currOp.RowCount );
+      if ( BusLink ) {
+        if ( !Batch ) {
+          Batch = new PortBatchEvent();
+        }
+        Batch->addRead( BusHandles[portId] );
+      } else {
+        PortEvent * const opEvent = currOp.RowCount ?
+          new PortEvent( std::vector<uint8_t>(), 0, PortEventAction::READ, currOp.FirstRow, currOp.RowCount ) :
+          new PortEvent();
+        Links[portId]->send( opEvent );
+      }
     }
     OpQueue.pop();
+    OpsDone++;
     return true;
   }
   return false;
@@ -227,19 +494,57 @@ void VerilatorTestLink::splitStr(const std::string& s,
 }
 
 void VerilatorTestLink::RecvPortEvent( SST::Event* ev, unsigned portId ) {
-  // should only be receiving read data
+  // read data or a subscription notification
   PortEvent * readEvent = reinterpret_cast<PortEvent *>( ev );
-  const std::vector<uint8_t>& ValidData = ExpectedReadData[portId].front();
   const std::vector<uint8_t>& ReadData = readEvent->getPacket();
-  output.verbose( CALL_INFO, 4, VerboseMasking::READ_DATA, "port%" PRIu32 " read data: size=%zu\n", portId, ReadData.size() );
-  for (size_t i=0; i<ReadData.size(); i++) {
+  if ( readEvent->getAction() == PortEventAction::SUBSCRIBE ) {
+    RecvNotification( portId, ReadData.data(), ReadData.size() );
+  } else if ( readEvent->getAction() == PortEventAction::CHANGES ) {
+    RecvChanges( portId, ReadData.data(), ReadData.size() );
+  } else {
+    // a row range read is answered with the range it covers
+    CheckReadData( portId, ReadData.data(), ReadData.size(), readEvent->getFirstRow(), readEvent->getRowCount() );
+  }
+  delete ev;
+}
+
+void VerilatorTestLink::RecvBatchEvent( SST::Event* ev ) {
+  // responses hold one entry per read, in the order they were requested, and
+  // subscription notifications
+  PortBatchEvent * readEvent = reinterpret_cast<PortBatchEvent *>( ev );
+  for (size_t i=0; i<readEvent->getNumOps(); i++) {
+    const auto it = BusPortIds.find( readEvent->getPort(i) );
+    if ( it == BusPortIds.end() ) {
+      output.fatal(CALL_INFO, -1, "Error: bus response for unmapped port handle %u\n", readEvent->getPort(i) );
+    }
+    if ( readEvent->getAction(i) == PortEventAction::SUBSCRIBE ) {
+      RecvNotification( it->second, readEvent->getData(i), readEvent->getDataLen(i) );
+    } else {
+      CheckReadData( it->second, readEvent->getData(i), readEvent->getDataLen(i) );
+    }
+  }
+  delete ev;
+}
+
+void VerilatorTestLink::CheckReadData( uint32_t portId, const uint8_t* ReadData, size_t Len,
+                                       uint32_t FirstRow, uint32_t RowCount ) {
+  const std::vector<uint8_t>& ValidData = ExpectedReadData[portId].front();
+  const std::pair<uint32_t, uint32_t> ValidRows = ExpectedRows[portId].front();
+  ExpectedRows[portId].pop();
+  if ( FirstRow != ValidRows.first || RowCount != ValidRows.second ) {
+    output.fatal(CALL_INFO, -1,
+                  "Error: Read data from port%" PRIu32 " covers rows %" PRIu32 "+%" PRIu32 " (should be %" PRIu32 "+%" PRIu32 ") at tick %" PRIu64 "\n",
+                  portId, FirstRow, RowCount, ValidRows.first, ValidRows.second, currTick );
+  }
+  output.verbose( CALL_INFO, 4, VerboseMasking::READ_DATA, "port%" PRIu32 " read data: size=%zu\n", portId, Len );
+  for (size_t i=0; i<Len; i++) {
     output.verbose( CALL_INFO, 4, VerboseMasking::READ_DATA, "byte %zu: %" PRIx8 "\n", i, ReadData[i] );
   }
   // compare received read data with expected read data
-  if ( ValidData.size() != ReadData.size() ) {
+  if ( ValidData.size() != Len ) {
     output.fatal(CALL_INFO, -1,
                   "Error: Read data from port%" PRIu32 " has incorrect size (%zu, should be %zu) at tick %" PRIu64 "\n",
-                  portId, ReadData.size(), ValidData.size(), currTick );
+                  portId, Len, ValidData.size(), currTick );
   }
   for (size_t i=0; i<ValidData.size(); i++) {
     if ( ValidData[i] != ReadData[i] ) {
@@ -248,8 +553,61 @@ void VerilatorTestLink::RecvPortEvent( SST::Event* ev, unsigned portId ) {
                     portId, ReadData[i], ValidData[i], currTick );
     }
   }
-  delete ev;
   ExpectedReadData[portId].pop();
+
+  // a port subscribed on change was pushed every value it took at a clock write, and
+  // the reads follow the clock writes of their tick
+  if ( Subscribed[portId] && SubInterval[portId] == 0 && !SubValues[portId].empty() &&
+       SubValues[portId] != ValidData ) {
+    output.fatal(CALL_INFO, -1,
+                  "Error: last value pushed for port%" PRIu32 " does not match its read at tick %" PRIu64 "\n",
+                  portId, currTick );
+  }
+}
+
+void VerilatorTestLink::RecvChanges( uint32_t portId, const uint8_t* Data, size_t Len ) {
+  // apply the changed rows to the mirror of the port and check the whole mirror
+  const uint32_t rowBytes = InfoVec[portId].Size / InfoVec[portId].Depth;
+  const size_t pairBytes = sizeof( uint32_t ) + rowBytes;
+  if ( Len % pairBytes != 0 ) {
+    output.fatal(CALL_INFO, -1, "Error: changes from port%" PRIu32 " end in a partial row (%zu bytes) at tick %" PRIu64 "\n",
+                  portId, Len, currTick );
+  }
+  std::vector<uint8_t> & Mirror = Mirrors[portId];
+  Mirror.resize( InfoVec[portId].Size );
+  for ( size_t off = 0; off < Len; off += pairBytes ) {
+    uint32_t row = 0;
+    for ( unsigned b = 0; b < sizeof( uint32_t ); b++ ) {
+      row |= static_cast<uint32_t>( Data[off+b] ) << ( 8 * b );
+    }
+    if ( row >= InfoVec[portId].Depth ) {
+      output.fatal(CALL_INFO, -1, "Error: changes from port%" PRIu32 " name row %" PRIu32 " of %" PRIu32 " at tick %" PRIu64 "\n",
+                    portId, row, InfoVec[portId].Depth, currTick );
+    }
+    std::copy( Data+off+sizeof( uint32_t ), Data+off+pairBytes, &Mirror[row*rowBytes] );
+  }
+  output.verbose( CALL_INFO, 4, VerboseMasking::READ_DATA, "port%" PRIu32 " changed rows: %zu\n", portId, Len / pairBytes );
+  CheckReadData( portId, Mirror.data(), Mirror.size() );
+}
+
+void VerilatorTestLink::RecvNotification( uint32_t portId, const uint8_t* Data, size_t Len ) {
+  output.verbose( CALL_INFO, 4, VerboseMasking::READ_DATA, "port%" PRIu32 " notification: size=%zu\n", portId, Len );
+  if ( !Subscribed[portId] ) {
+    output.fatal(CALL_INFO, -1, "Error: notification for unsubscribed port%" PRIu32 " at tick %" PRIu64 "\n",
+                  portId, currTick );
+  }
+  if ( Len != InfoVec[portId].Size ) {
+    output.fatal(CALL_INFO, -1, "Error: notification for port%" PRIu32 " has incorrect size (%zu, should be %" PRIu32 ")\n",
+                  portId, Len, InfoVec[portId].Size );
+  }
+  // after the initial value, a subscription on change only pushes new values
+  const std::vector<uint8_t> Value( Data, Data+Len );
+  if ( SubInterval[portId] == 0 && !SubValues[portId].empty() && SubValues[portId] == Value ) {
+    output.fatal(CALL_INFO, -1, "Error: port%" PRIu32 " pushed an unchanged value at tick %" PRIu64 "\n",
+                  portId, currTick );
+  }
+  SubValues[portId] = Value;
+  Notifications++;
 }
 
 bool VerilatorTestLink::clock(SST::Cycle_t currentCycle){
@@ -259,8 +617,15 @@ bool VerilatorTestLink::clock(SST::Cycle_t currentCycle){
     primaryComponentOKToEndSim();
     return true;
   }
+  if( ForkTick && currTick == ForkTick ){
+    ForkChildren();
+  }
   // drive the test links (including the clock) if there are test ops for this tick
   while ( ExecTestOp() ); 
+  if ( Batch ) {
+    BusLink->send( Batch );
+    Batch = nullptr;
+  }
   currTick++;
 
   return false;
@@ -13,12 +13,14 @@
 
 // -- Standard Headers
 #include <list>
+#include <map>
 #include <memory>
 #include <queue>
 #include <random>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
+#include <sys/types.h>
 #include <time.h>
 #include <tuple>
 #include <utility>
@@ -30,6 +32,9 @@
 // -- Verilator SST Headers
 #include "verilatorSSTSubcomponent.h"
 
+// -- Test Headers
+#include "BenchRun.h"
+
 namespace SST::VerilatorSST {
 
 // struct used to define characteristics of each exposed port
@@ -38,13 +43,14 @@ struct PortDef {
   uint32_t Size;
   bool Write;
   bool Read;
+  uint32_t Depth;   // rows of an array port; Size covers all of them
 
   // Default constructor
-  PortDef() : PortId( 0 ), Size( 0 ), Write( false ), Read ( false ) { }
+  PortDef() : PortId( 0 ), Size( 0 ), Write( false ), Read ( false ), Depth( 1 ) { }
 
   // Full constructor
-  PortDef( uint32_t PortId, uint32_t Size, bool Write, bool Read ) :
-              PortId( PortId ), Size( Size ), Write( Write ), Read( Read ) { }
+  PortDef( uint32_t PortId, uint32_t Size, bool Write, bool Read, uint32_t Depth = 1 ) :
+              PortId( PortId ), Size( Size ), Write( Write ), Read( Read ), Depth( Depth ) { }
 };
 
 // struct used to define each port operation used for testing
@@ -53,13 +59,21 @@ struct TestOp {
   uint64_t * Values;
   uint64_t AtTick;
   bool isWrite;
+  bool isSubscribe;   // subscribe to the port; Values[0] is the sampling interval
+  bool isUnsubscribe; // end the subscription to the port
+  bool isChanges;     // read the changed rows; Values hold the expected whole port
+  uint32_t FirstRow;  // first row of a row range op
+  uint32_t RowCount;  // rows of a row range op; 0 for the whole port
 
   // Default constructor
-  TestOp() : PortId( 0 ), isWrite(false), Values( nullptr ), AtTick( 0 ) { }
+  TestOp() : PortId( 0 ), isWrite(false), Values( nullptr ), AtTick( 0 ), isSubscribe( false ),
+             isUnsubscribe( false ), isChanges( false ), FirstRow( 0 ), RowCount( 0 ) { }
 
   // Full constructor
-  TestOp( uint32_t PortId, bool isWrite, uint64_t * Values, uint64_t AtTick ) : 
-          PortId( PortId ), isWrite(isWrite), Values( Values ), AtTick( AtTick ) { }
+  TestOp( uint32_t PortId, bool isWrite, uint64_t * Values, uint64_t AtTick,
+          uint32_t FirstRow = 0, uint32_t RowCount = 0 ) : 
+          PortId( PortId ), isWrite(isWrite), Values( Values ), AtTick( AtTick ), isSubscribe( false ),
+          isUnsubscribe( false ), isChanges( false ), FirstRow( FirstRow ), RowCount( RowCount ) { }
 };
 
 class VerilatorTestLink : public SST::Component {
@@ -98,14 +112,29 @@ public:
     output.verbose( CALL_INFO, 8, VerboseMasking::INIT, "Converting test op: %s\n", StrOp.c_str());
     std::vector<std::string> op;
     splitStr( StrOp, ':', op );
-    const std::string portName = op[0];
     const bool isWrite = (op[1] == "write");
-    if (PortMap.find(op[0]) == PortMap.end()) {
+    // "name[first-last]" addresses rows first..last of an array port
+    std::string portName = op[0];
+    uint32_t firstRow = 0;
+    uint32_t rowCount = 0;
+    const std::string::size_type bracket = portName.find('[');
+    if ( bracket != std::string::npos ) {
+      std::vector<std::string> rows;
+      splitStr( portName.substr( bracket+1, portName.size()-bracket-2 ), '-', rows );
+      firstRow = std::stoul( rows.front() );
+      rowCount = std::stoul( rows.back() ) + 1 - firstRow;
+      portName = portName.substr( 0, bracket );
+    }
+    if (PortMap.find(portName) == PortMap.end()) {
       output.fatal( CALL_INFO, -1, "Error: Test op (%s) has unmapped port name\n", StrOp.c_str());
     }
-    const PortDef portInfo = PortMap[op[0]];
+    const PortDef portInfo = PortMap[portName];
     const uint32_t id = portInfo.PortId;
-    uint32_t size = portInfo.Size;
+    if ( rowCount && firstRow + rowCount > portInfo.Depth ) {
+      output.fatal( CALL_INFO, -1, "Error: Test op (%s) addresses rows past the %" PRIu32 " row port\n",
+                    StrOp.c_str(), portInfo.Depth );
+    }
+    uint32_t size = rowCount ? rowCount * ( portInfo.Size / portInfo.Depth ) : portInfo.Size;
     uint32_t nvals = size / 8;
     const  uint32_t rem = (size % 8 == 0) ? 0 : 1;
     uint64_t * const values = new uint64_t[nvals+rem];
@@ -120,7 +149,10 @@ public:
       nvals++;
     }
     const uint64_t tick = std::stoull( op[2+nvals] );
-    const TestOp toRet( id, isWrite, values, tick );
+    TestOp toRet( id, isWrite, values, tick, firstRow, rowCount );
+    toRet.isSubscribe = (op[1] == "subscribe");
+    toRet.isUnsubscribe = (op[1] == "unsubscribe");
+    toRet.isChanges = (op[1] == "changes");
     return toRet;
   }
 
@@ -144,10 +176,16 @@ public:
     {"verbose",     "Sets the verbosity",       "0"},
     {"clockFreq",   "Clock frequency",          "1GHz"},
     {"num_ports",   "Number of ports",          "0"},
-    {"portMap",     "portname:id:size:direction pairings",     "" },
+    {"portMap",     "portname:id:size:direction[:depth] pairings; depth is the row count of an array port", "" },
     {"testFile",    "name of file holding test ops", ""},
-    {"testOps",     "List of 'portname:vals:tick' strings to drive testing", ""},
+    {"testOps",     "List of 'portname:action:vals:tick' strings to drive testing; action is write, read, changes, subscribe (vals is the interval) or unsubscribe, and portname[first-last] addresses a row range", ""},
     {"numCycles",   "Number of cycles to exec", "1000"},
+    {"useBus",      "Drive all ports through batched events on the bus link", "0"},
+    {"forkTick",    "Tick at which one child simulation is forked per forkTestFiles entry; 0 disables", "0"},
+    {"forkTestFiles", "Test op files the forked children apply from forkTick on", ""},
+    {"forkSummary", "File the parent writes the per-child results to", ""},
+    {"forkOutputDir", "Directory holding the fork<N> output directory of each child", "."},
+    {"benchReport", "Print a BENCH line with the run time, ops and allocations at finish", "0"},
   )
 
   // -------------------------------------------------------
@@ -157,6 +195,10 @@ public:
     {"port%(num_ports)d",
       "Ports which connect to tested verilated subcomponents.",
       {"SST::VerilatorSST::PortEvent", ""}
+    },
+    {"bus",
+      "Batched access to all ports of the tested verilated subcomponent (useBus).",
+      {"SST::VerilatorSST::PortBatchEvent", ""}
     }
   )
 
@@ -177,12 +219,40 @@ private:
   SST::Link ** Links;                           ///< VerilatorTestLink: list of links (one for each port in the verilator model)
   std::queue<TestOp> OpQueue;                   ///< VerilatorTestLink: queue holding test operations to be applied
   std::vector<std::queue<std::vector<uint8_t>>> ExpectedReadData; ///< VerilatorTestLink: vector of queues to hold expected read data for each port
+  std::vector<std::queue<std::pair<uint32_t, uint32_t>>> ExpectedRows; ///< VerilatorTestLink: first row and row count of each expected read; 0 rows for the whole port
   uint64_t currTick = 0;                          ///< VerilatorTestLink: current tick of this test component
+  SST::Link * BusLink = nullptr;                  ///< VerilatorTestLink: batched port access link (useBus)
+  PortBatchEvent * Batch = nullptr;               ///< VerilatorTestLink: bus operations collected this tick
+  std::vector<PortHandle> BusHandles;             ///< VerilatorTestLink: subcomponent port handle of each port ID
+  std::map<PortHandle, uint32_t> BusPortIds;      ///< VerilatorTestLink: port ID of each subcomponent port handle
+  uint64_t ForkTick = 0;                          ///< VerilatorTestLink: tick at which the children are forked
+  std::vector<std::string> ForkTestFiles;         ///< VerilatorTestLink: test op file of each forked child
+  std::string ForkSummary;                        ///< VerilatorTestLink: per-child result file
+  std::string ForkOutputDir;                      ///< VerilatorTestLink: parent of the per-child output directories
+  std::vector<pid_t> ForkPids;                    ///< VerilatorTestLink: forked children the parent waits for
+  bool BenchReport = false;                       ///< VerilatorTestLink: print the BENCH line at finish
+  uint64_t OpsDone = 0;                           ///< VerilatorTestLink: test operations executed
+  BenchRun Bench;                                 ///< VerilatorTestLink: host time and allocations of the measured run
+  std::vector<bool> Subscribed;                   ///< VerilatorTestLink: port ID has an active subscription
+  std::vector<uint64_t> SubInterval;              ///< VerilatorTestLink: sampling interval of each subscription
+  std::vector<std::vector<uint8_t>> SubValues;    ///< VerilatorTestLink: last value pushed for each subscribed port
+  uint64_t SubscribeOps = 0;                      ///< VerilatorTestLink: subscriptions requested
+  uint64_t Notifications = 0;                     ///< VerilatorTestLink: subscription notifications received
+  std::map<uint32_t, std::vector<uint8_t>> Mirrors; ///< VerilatorTestLink: port values rebuilt from changes ops
 
   void InitPortMap( const SST::Params& params );    ///< VerilatorTestLink: initialize name:port_info mapping
   void InitLinkConfig( const SST::Params& params ); ///< VerilatorTestLink: configure the links for each port
   void InitTestOps( const SST::Params& params );    ///< VerilatorTestLink: load in the test operations from params
+  void LoadTestFile( const std::string& fileName ); ///< VerilatorTestLink: queue the test operations of a test file
+  void ForkChildren();  ///< VerilatorTestLink: fork the children; each child switches to its own test file
+  void SplitOpenFiles( const std::string& Dir ); ///< VerilatorTestLink: move the child's open output files into Dir
+  void WaitChildren();  ///< VerilatorTestLink: wait for the children and report their results
   void RecvPortEvent( SST::Event* ev, unsigned portId );  ///< VerilatorTestLink: general port handler
+  void RecvBatchEvent( SST::Event* ev );  ///< VerilatorTestLink: bus response handler
+  void CheckReadData( uint32_t portId, const uint8_t* ReadData, size_t Len,
+                      uint32_t FirstRow = 0, uint32_t RowCount = 0 ); ///< VerilatorTestLink: compare read data and its row range with the next expected value
+  void RecvNotification( uint32_t portId, const uint8_t* Data, size_t Len ); ///< VerilatorTestLink: record a pushed subscription value
+  void RecvChanges( uint32_t portId, const uint8_t* Data, size_t Len ); ///< VerilatorTestLink: apply changed rows to the port mirror and check it
   bool ExecTestOp();  ///< VerilatorTestLink: perform the next queued test operation
 
 };  // class VerilatorTestLink
@@ -0,0 +1,107 @@
+//
+// _FlightRecorder_cpp_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "FlightRecorder.h"
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+namespace SST::VerilatorSST {
+
+namespace {
+
+std::mutex RegistryLock;
+
+std::vector<FlightRecorder*>& registry(){
+  static std::vector<FlightRecorder*>* Recorders = new std::vector<FlightRecorder*>();
+  return *Recorders;
+}
+
+template<typename T>
+void put(std::FILE* F, T Val){
+  std::fwrite(&Val, sizeof(T), 1, F);
+}
+
+void putStr(std::FILE* F, const std::string& S){
+  const uint16_t Len = static_cast<uint16_t>(std::min<size_t>(S.size(), UINT16_MAX));
+  put(F, Len);
+  std::fwrite(S.data(), 1, Len, F);
+}
+
+} // namespace
+
+FlightRecorder::FlightRecorder(const std::string& Path, const std::string& Device,
+                               std::vector<PortInfo> Ports, size_t Entries, uint32_t SlotBytes)
+  : Path(Path), Device(Device), Ports(std::move(Ports)), Ring(std::max<size_t>(Entries, 1)),
+    Data(Ring.size() * SlotBytes), SlotBytes(SlotBytes), Next(0), Count(0), Armed(true){
+  static std::once_flag AtExit;
+  std::call_once(AtExit, [](){ std::atexit(&FlightRecorder::dumpAtExit); });
+  std::lock_guard<std::mutex> Lock(RegistryLock);
+  registry().push_back(this);
+}
+
+FlightRecorder::~FlightRecorder(){
+  std::lock_guard<std::mutex> Lock(RegistryLock);
+  auto& Recorders = registry();
+  Recorders.erase(std::remove(Recorders.begin(), Recorders.end(), this), Recorders.end());
+}
+
+void FlightRecorder::disarm(){
+  Armed = false;
+}
+
+bool FlightRecorder::dump(const std::string& Reason){
+  std::FILE* F = std::fopen(Path.c_str(), "wb");
+  if( !F ){
+    return false;
+  }
+
+  std::fwrite("VSSTREC2", 1, 8, F);
+  putStr(F, Device);
+  putStr(F, Reason);
+  put(F, static_cast<uint32_t>(Ports.size()));
+  for( const auto& Port : Ports ){
+    putStr(F, Port.Name);
+    put(F, Port.Width);
+    put(F, Port.Depth);
+  }
+  put(F, SlotBytes);
+
+  // the oldest record is at Next once the ring has wrapped
+  const uint64_t Kept = std::min<uint64_t>(Count, Ring.size());
+  const size_t First = (Count > Ring.size()) ? Next : 0;
+  put(F, Kept);
+  for( uint64_t i = 0; i < Kept; i++ ){
+    const size_t Slot = (First + i) % Ring.size();
+    const Record& R = Ring[Slot];
+    put(F, R.Tick);
+    put(F, R.Port);
+    put(F, static_cast<uint8_t>(R.Act));
+    put(F, R.Len);
+    put(F, R.Row);
+    std::fwrite(&Data[Slot * SlotBytes], 1, std::min(R.Len, SlotBytes), F);
+  }
+
+  return std::fclose(F) == 0;
+}
+
+void FlightRecorder::dumpAtExit(){
+  std::lock_guard<std::mutex> Lock(RegistryLock);
+  for( FlightRecorder* Recorder : registry() ){
+    if( Recorder->Armed ){
+      Recorder->dump("exit");
+      Recorder->Armed = false;
+    }
+  }
+}
+
+} // namespace SST::VerilatorSST
+
+// EOF
@@ -0,0 +1,102 @@
+//
+// _FlightRecorder_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _FLIGHTRECORDER_H_
+#define _FLIGHTRECORDER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace SST::VerilatorSST {
+
+// Dump file layout (little-endian), decoded by scripts/flight-recorder.py:
+//   char[8]  "VSSTREC2"
+//   string   device, string reason          (uint16 length + bytes)
+//   uint32   number of ports, then per port: string name, uint32 width, uint32 depth
+//   uint32   bytes kept per record
+//   uint64   number of records, then oldest first:
+//            uint64 tick, uint32 port, uint8 action, uint32 packet bytes,
+//            uint32 first row, min(packet bytes, bytes kept) value bytes
+
+/// Fixed-size ring of the most recent port accesses
+class FlightRecorder {
+public:
+  /// Port description written to the dump header
+  struct PortInfo {
+    std::string Name;
+    uint32_t Width;
+    uint32_t Depth;
+  };
+
+  /// Record action; matches PortEventAction
+  enum Action : uint8_t {
+    WRITE = 0,
+    READ  = 1,
+  };
+
+  /// Allocates the ring; Entries records keep at most SlotBytes value bytes each.
+  /// SlotBytes must be nonzero; the subcomponent rejects recorderBytes=0
+  FlightRecorder(const std::string& Path, const std::string& Device,
+                 std::vector<PortInfo> Ports, size_t Entries, uint32_t SlotBytes);
+
+  /// Removes the recorder from the exit-time dump list
+  ~FlightRecorder();
+
+  /// Record a port access of Len bytes starting at Row; does not allocate
+  void record(uint64_t Tick, uint32_t Port, Action Act, const uint8_t* Buf, uint32_t Len,
+              uint32_t Row = 0){
+    Record& R = Ring[Next];
+    R.Tick = Tick;
+    R.Port = Port;
+    R.Act = Act;
+    R.Len = Len;
+    R.Row = Row;
+    std::memcpy(&Data[Next * SlotBytes], Buf, std::min(Len, SlotBytes));
+    Next = (Next + 1 == Ring.size()) ? 0 : Next + 1;
+    Count++;
+  }
+
+  /// Write the ring to the dump file; returns false if the file could not be written
+  bool dump(const std::string& Reason);
+
+  /// Stop dumping this recorder when the process exits
+  void disarm();
+
+private:
+  struct Record {
+    uint64_t Tick;
+    uint32_t Port;
+    uint32_t Len;
+    uint32_t Row;
+    Action Act;
+  };
+
+  std::string Path;               ///< FlightRecorder: dump file
+  std::string Device;             ///< FlightRecorder: recorded device name
+  std::vector<PortInfo> Ports;    ///< FlightRecorder: port table, indexed by port handle
+  std::vector<Record> Ring;       ///< FlightRecorder: record ring
+  std::vector<uint8_t> Data;      ///< FlightRecorder: value bytes, SlotBytes per record
+  uint32_t SlotBytes;             ///< FlightRecorder: value bytes kept per record
+  size_t Next;                    ///< FlightRecorder: next ring slot
+  uint64_t Count;                 ///< FlightRecorder: records written
+  bool Armed;                     ///< FlightRecorder: dump at process exit?
+
+  /// Dump every armed recorder; registered with atexit so fatal errors leave a dump
+  static void dumpAtExit();
+};
+
+} // namespace SST::VerilatorSST
+
+#endif  // _FLIGHTRECORDER_H_
+
+// EOF
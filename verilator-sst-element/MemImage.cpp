@@ -0,0 +1,281 @@
+//
+// _MemImage_cpp_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "MemImage.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SST::VerilatorSST {
+
+namespace {
+
+bool hasSuffix(const std::string& S, const char* Suffix){
+  const size_t Len = std::strlen(Suffix);
+  return S.size() >= Len && S.compare(S.size() - Len, Len, Suffix) == 0;
+}
+
+int hexDigit(char C){
+  if( C >= '0' && C <= '9' ) return C - '0';
+  if( C >= 'a' && C <= 'f' ) return C - 'a' + 10;
+  if( C >= 'A' && C <= 'F' ) return C - 'A' + 10;
+  if( C == 'x' || C == 'X' || C == 'z' || C == 'Z' ) return 0;   // unknown bits load as zero
+  return -1;
+}
+
+std::string sysError(const char* What, const std::string& Path){
+  return std::string(What) + " " + Path + ": " + std::strerror(errno);
+}
+
+// PT_LOAD segments of a 32 or 64 bit little-endian ELF file
+template<typename Ehdr, typename Phdr>
+bool placeSegments(const uint8_t* File, uint64_t Len, uint64_t Capacity, uint64_t Base,
+                   std::vector<uint8_t>& Out, std::string& Error){
+  if( Len < sizeof(Ehdr) ){
+    Error = "truncated ELF header";
+    return false;
+  }
+  Ehdr Hdr;
+  std::memcpy(&Hdr, File, sizeof(Hdr));
+
+  std::vector<Phdr> Loads;
+  for( unsigned i=0; i<Hdr.e_phnum; i++ ){
+    const uint64_t Rel = uint64_t(i) * Hdr.e_phentsize;
+    if( Hdr.e_phoff > Len || Rel > Len - Hdr.e_phoff || sizeof(Phdr) > Len - Hdr.e_phoff - Rel ){
+      Error = "truncated ELF program header table";
+      return false;
+    }
+    Phdr Seg;
+    std::memcpy(&Seg, File + Hdr.e_phoff + Rel, sizeof(Seg));
+    if( Seg.p_type != PT_LOAD || Seg.p_memsz == 0 ){
+      continue;
+    }
+    if( Seg.p_filesz > Seg.p_memsz || Seg.p_offset > Len || Seg.p_filesz > Len - Seg.p_offset ){
+      Error = "ELF segment " + std::to_string(i) + " lies outside the file";
+      return false;
+    }
+    // checked before anything is allocated
+    if( Seg.p_paddr < Base || Seg.p_paddr - Base > Capacity || Seg.p_memsz > Capacity - (Seg.p_paddr - Base) ){
+      Error = "ELF segment " + std::to_string(i) + " does not fit the " + std::to_string(Capacity) +
+              " byte memory at base " + std::to_string(Base);
+      return false;
+    }
+    Loads.push_back(Seg);
+  }
+  if( Loads.empty() ){
+    Error = "ELF file has no loadable segments";
+    return false;
+  }
+
+  uint64_t End = 0;
+  for( const Phdr& Seg : Loads ){
+    End = std::max<uint64_t>(End, Seg.p_paddr - Base + Seg.p_memsz);
+  }
+  // bss and gaps between segments are zero
+  Out.assign(End, 0);
+  for( const Phdr& Seg : Loads ){
+    if( Seg.p_filesz ){
+      std::memcpy(&Out[Seg.p_paddr - Base], File + Seg.p_offset, Seg.p_filesz);
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+MemImage::~MemImage(){
+  if( Map ){
+    munmap(Map, MapLen);
+  }
+}
+
+const char* MemImage::formatName(Format F){
+  switch( F ){
+  case HEX: return "hex";
+  case ELF: return "elf";
+  default:  return "binary";
+  }
+}
+
+bool MemImage::open(const std::string& Path, unsigned RowBytes, uint64_t Depth, uint64_t Base,
+                    std::string& Error){
+  const int Fd = ::open(Path.c_str(), O_RDONLY);
+  if( Fd < 0 ){
+    Error = sysError("could not open", Path);
+    return false;
+  }
+  struct stat St;
+  if( fstat(Fd, &St) != 0 ){
+    Error = sysError("could not stat", Path);
+    ::close(Fd);
+    return false;
+  }
+  if( St.st_size == 0 ){
+    Error = Path + " is empty";
+    ::close(Fd);
+    return false;
+  }
+  MapLen = static_cast<uint64_t>(St.st_size);
+  Map = mmap(nullptr, MapLen, PROT_READ, MAP_PRIVATE, Fd, 0);
+  ::close(Fd);
+  if( Map == MAP_FAILED ){
+    Map = nullptr;
+    Error = sysError("could not map", Path);
+    return false;
+  }
+  madvise(Map, MapLen, MADV_SEQUENTIAL);
+
+  const uint8_t* File = static_cast<const uint8_t*>(Map);
+  if( MapLen >= SELFMAG && std::memcmp(File, ELFMAG, SELFMAG) == 0 ){
+    Fmt = ELF;
+    if( !decodeELF(File, MapLen, uint64_t(RowBytes) * Depth, Base, Error) ){
+      Error = Path + ": " + Error;
+      return false;
+    }
+  }else if( hasSuffix(Path, ".hex") || hasSuffix(Path, ".mem") || hasSuffix(Path, ".vmem") ){
+    Fmt = HEX;
+    if( !decodeHex(reinterpret_cast<const char*>(File), MapLen, RowBytes, Depth, Error) ){
+      Error = Path + ": " + Error;
+      return false;
+    }
+  }else{
+    // the file already holds packed rows
+    Fmt = BIN;
+    Data = File;
+    Size = MapLen;
+    return true;
+  }
+
+  // decoded images no longer need the file
+  munmap(Map, MapLen);
+  Map = nullptr;
+  Data = Decoded.data();
+  Size = Decoded.size();
+  return true;
+}
+
+bool MemImage::decodeHex(const char* Text, uint64_t Len, unsigned RowBytes, uint64_t Depth,
+                         std::string& Error){
+  uint64_t Row = 0;
+  unsigned Line = 1;
+  uint64_t i = 0;
+  while( i < Len ){
+    const char C = Text[i];
+    if( C == '\n' ){
+      Line++;
+      i++;
+    }else if( C == ' ' || C == '\t' || C == '\r' ){
+      i++;
+    }else if( C == '/' && i+1 < Len && Text[i+1] == '/' ){
+      while( i < Len && Text[i] != '\n' ){
+        i++;
+      }
+    }else if( C == '/' && i+1 < Len && Text[i+1] == '*' ){
+      for( i += 2; i+1 < Len && !(Text[i] == '*' && Text[i+1] == '/'); i++ ){
+        Line += Text[i] == '\n';
+      }
+      i += 2;
+    }else if( C == '@' ){
+      // saturate rather than wrap; the row is checked against Depth when a word is placed
+      Row = 0;
+      for( i++; i < Len && (hexDigit(Text[i]) >= 0 || Text[i] == '_'); i++ ){
+        if( Text[i] != '_' ){
+          Row = Row > (UINT64_MAX >> 4) ? UINT64_MAX : (Row << 4) | hexDigit(Text[i]);
+        }
+      }
+    }else if( hexDigit(C) >= 0 ){
+      // digits are most significant first; fill the row from its last nibble
+      uint64_t End = i;
+      while( End < Len && (hexDigit(Text[End]) >= 0 || Text[End] == '_') ){
+        End++;
+      }
+      if( Row >= Depth ){
+        Error = "line " + std::to_string(Line) + ": row " + std::to_string(Row) +
+                " is past the " + std::to_string(Depth) + " row memory";
+        return false;
+      }
+      if( Decoded.size() < (Row + 1) * RowBytes ){
+        Decoded.resize((Row + 1) * RowBytes, 0);
+      }
+      uint8_t* Dst = &Decoded[Row * RowBytes];
+      unsigned Nibble = 0;
+      for( uint64_t j = End; j > i; j-- ){
+        if( Text[j-1] == '_' ){
+          continue;
+        }
+        const int V = hexDigit(Text[j-1]);
+        if( Nibble < 2 * RowBytes ){
+          Dst[Nibble / 2] |= static_cast<uint8_t>(V << (4 * (Nibble % 2)));
+        }else if( V != 0 ){
+          Error = "line " + std::to_string(Line) + ": word is wider than " +
+                  std::to_string(RowBytes) + " bytes";
+          return false;
+        }
+        Nibble++;
+      }
+      Row++;
+      i = End;
+    }else{
+      Error = "line " + std::to_string(Line) + ": unexpected character '" + std::string(1, C) + "'";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MemImage::decodeELF(const uint8_t* File, uint64_t Len, uint64_t Capacity, uint64_t Base,
+                         std::string& Error){
+  if( Len < EI_NIDENT || File[EI_DATA] != ELFDATA2LSB ){
+    Error = "only little-endian ELF files are supported";
+    return false;
+  }
+  if( File[EI_CLASS] == ELFCLASS32 ){
+    return placeSegments<Elf32_Ehdr, Elf32_Phdr>(File, Len, Capacity, Base, Decoded, Error);
+  }
+  if( File[EI_CLASS] == ELFCLASS64 ){
+    return placeSegments<Elf64_Ehdr, Elf64_Phdr>(File, Len, Capacity, Base, Decoded, Error);
+  }
+  Error = "unknown ELF class";
+  return false;
+}
+
+bool MemImage::dump(const std::string& Path, uint64_t Len,
+                    const std::function<void(uint8_t*)>& Fill, std::string& Error){
+  const int Fd = ::open(Path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if( Fd < 0 ){
+    Error = sysError("could not create", Path);
+    return false;
+  }
+  if( ftruncate(Fd, static_cast<off_t>(Len)) != 0 ){
+    Error = sysError("could not size", Path);
+    ::close(Fd);
+    return false;
+  }
+
+  // the rows are written straight into the page cache; no staging copy
+  void* Out = mmap(nullptr, Len, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+  ::close(Fd);
+  if( Out == MAP_FAILED ){
+    Error = sysError("could not map", Path);
+    return false;
+  }
+  Fill(static_cast<uint8_t*>(Out));
+  munmap(Out, Len);
+  return true;
+}
+
+} // namespace SST::VerilatorSST
+
+// EOF
@@ -0,0 +1,90 @@
+//
+// _MemImage_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _MEMIMAGE_H_
+#define _MEMIMAGE_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace SST::VerilatorSST {
+
+// Memory images hold the port packet layout: row r at byte r*RowBytes,
+// each row little-endian. The format is chosen from the file:
+//   ELF      (by magic)           PT_LOAD segments placed at byte offset
+//                                 p_paddr - Base of the packed rows
+//   hex      (.hex, .mem, .vmem)  $readmemh text; one word per row, "@addr"
+//                                 sets the next row, // and /* */ comments
+//   binary   (anything else)      the packed rows themselves, used in place
+// Decoded images never grow past Depth rows; anything beyond is an error
+
+/// Read-only view of a memory image file
+class MemImage {
+public:
+  /// Image file format
+  enum Format : uint8_t {
+    BIN = 0,
+    HEX = 1,
+    ELF = 2,
+  };
+
+  MemImage() = default;
+  MemImage(const MemImage&) = delete;
+  MemImage& operator=(const MemImage&) = delete;
+
+  /// Unmaps the image file
+  ~MemImage();
+
+  /// Map Path and decode it for a memory of Depth rows of RowBytes bytes; ELF segments
+  /// are placed relative to Base. Returns false and sets Error on failure
+  bool open(const std::string& Path, unsigned RowBytes, uint64_t Depth, uint64_t Base,
+            std::string& Error);
+
+  /// Packed image bytes; points into the file mapping for binary images
+  const uint8_t* data() const { return Data; }
+
+  /// Number of packed image bytes
+  uint64_t size() const { return Size; }
+
+  /// Format the image was decoded from
+  Format format() const { return Fmt; }
+
+  /// Printable name of a format
+  static const char* formatName(Format F);
+
+  /// Create Path with Len bytes, mapped shared, and let Fill write them in place;
+  /// returns false and sets Error if the file could not be created or mapped
+  static bool dump(const std::string& Path, uint64_t Len,
+                   const std::function<void(uint8_t*)>& Fill, std::string& Error);
+
+private:
+  void* Map = nullptr;            ///< MemImage: file mapping
+  uint64_t MapLen = 0;            ///< MemImage: file mapping length
+  const uint8_t* Data = nullptr;  ///< MemImage: packed image bytes
+  uint64_t Size = 0;              ///< MemImage: number of packed image bytes
+  std::vector<uint8_t> Decoded;   ///< MemImage: decoded hex and ELF images
+  Format Fmt = BIN;               ///< MemImage: image file format
+
+  /// Decode $readmemh text into Decoded
+  bool decodeHex(const char* Text, uint64_t Len, unsigned RowBytes, uint64_t Depth,
+                 std::string& Error);
+
+  /// Place the PT_LOAD segments of an ELF file into Decoded
+  bool decodeELF(const uint8_t* File, uint64_t Len, uint64_t Capacity, uint64_t Base,
+                 std::string& Error);
+};
+
+} // namespace SST::VerilatorSST
+
+#endif  // _MEMIMAGE_H_
+
+// EOF
@@ -0,0 +1,562 @@
+//
+// _PortPacking_cpp_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "PortPacking.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PORTPACKING_X86 1
+#include <immintrin.h>
+#define PORTPACKING_SSE  __attribute__((target("ssse3,sse4.1")))
+#define PORTPACKING_AVX2 __attribute__((target("avx2")))
+#else
+#define PORTPACKING_X86 0
+#endif
+
+using namespace SST::VerilatorSST::PortPacking;
+
+namespace {
+
+// ---------------------------------------------------------------
+// Scalar kernels; also used for the tails of the vector kernels
+// ---------------------------------------------------------------
+void packRowsScalar(const uint8_t* Src, uint8_t* Dst, unsigned Bytes,
+                    unsigned Stride, uint8_t Mask, uint64_t Rows){
+  if( Stride == Bytes ){
+    // dense rows only need their top byte masked
+    std::memcpy(Dst, Src, Bytes*Rows);
+    for( uint64_t r=0; r<Rows; r++ ){
+      Dst[r*Stride + Bytes-1] &= Mask;
+    }
+    return;
+  }
+  for( uint64_t r=0; r<Rows; r++ ){
+    uint8_t* D = Dst + (r*Stride);
+    std::memcpy(D, Src + (r*Bytes), Bytes);
+    D[Bytes-1] &= Mask;
+    std::memset(D + Bytes, 0, Stride - Bytes);
+  }
+}
+
+void unpackRowsScalar(const uint8_t* Src, uint8_t* Dst, unsigned Bytes,
+                      unsigned Stride, uint64_t Rows){
+  for( uint64_t r=0; r<Rows; r++ ){
+    std::memcpy(Dst + (r*Bytes), Src + (r*Stride), Bytes);
+  }
+}
+
+void packVecvalRow(const uint8_t* Src, s_vpi_vecval* Dst, unsigned Bytes, unsigned FirstWord){
+  const unsigned Words = getNumWords(Bytes*8);
+  unsigned w = FirstWord;
+  for( ; w<Bytes/4; w++ ){
+    std::memcpy(&Dst[w].aval, Src + w*4, 4);
+    Dst[w].bval = 0;
+  }
+  for( ; w<Words; w++ ){
+    uint32_t Aval = 0;
+    const unsigned Last = (w*4+4 < Bytes) ? w*4+4 : Bytes;
+    for( unsigned k=w*4; k<Last; k++ ){
+      Aval |= static_cast<uint32_t>(Src[k]) << ((k-w*4)*8);
+    }
+    Dst[w].aval = Aval;
+    Dst[w].bval = 0;
+  }
+}
+
+void unpackVecvalRow(const s_vpi_vecval* Src, uint8_t* Dst, unsigned Bytes, unsigned FirstByte){
+  unsigned k = FirstByte;
+  for( ; k+4<=Bytes; k+=4 ){
+    std::memcpy(Dst + k, &Src[k/4].aval, 4);
+  }
+  for( ; k<Bytes; k++ ){
+    Dst[k] = (Src[k/4].aval >> ((k%4)*8)) & 255;
+  }
+}
+
+void packVecvalScalar(const uint8_t* Src, s_vpi_vecval* Dst, unsigned Bytes,
+                      unsigned Words, uint64_t Rows, bool Reverse){
+  for( uint64_t r=0; r<Rows; r++ ){
+    const uint64_t Row = Reverse ? Rows-r-1 : r;
+    packVecvalRow(Src + (r*Bytes), Dst + (Row*Words), Bytes, 0);
+  }
+}
+
+void unpackVecvalScalar(const s_vpi_vecval* Src, uint8_t* Dst, unsigned Bytes,
+                        unsigned Words, uint64_t Rows, bool Reverse){
+  for( uint64_t r=0; r<Rows; r++ ){
+    const uint64_t Row = Reverse ? Rows-r-1 : r;
+    unpackVecvalRow(Src + (Row*Words), Dst + (r*Bytes), Bytes, 0);
+  }
+}
+
+// marks the rows holding the set bits of Diff, a byte mask of the 64 bytes at Off
+inline void markRows(uint64_t Diff, uint64_t Off, unsigned Stride, uint64_t* Dirty){
+  while( Diff ){
+    const uint64_t Row = (Off + __builtin_ctzll(Diff)) / Stride;
+    Dirty[Row/64] |= 1ull << (Row%64);
+    // the remaining bytes of the row are already covered
+    const uint64_t End = (Row+1)*Stride - Off;
+    Diff = (End >= 64) ? 0 : (Diff & (~0ull << End));
+  }
+}
+
+// the diff kernels scan bytes [First, Bytes) of the model storage
+void diffRowsScalar(const uint8_t* Src, uint8_t* Shadow, unsigned Stride,
+                    uint64_t First, uint64_t Bytes, uint64_t* Dirty){
+  uint64_t k = First;
+  for( ; k+8<=Bytes; k+=8 ){
+    uint64_t A, B;
+    std::memcpy(&A, Src + k, 8);
+    std::memcpy(&B, Shadow + k, 8);
+    if( A != B ){
+      const uint64_t X = A ^ B;
+      uint64_t Diff = 0;
+      for( unsigned b=0; b<8; b++ ){
+        Diff |= static_cast<uint64_t>(((X >> (b*8)) & 255) != 0) << b;
+      }
+      markRows(Diff, k, Stride, Dirty);
+      std::memcpy(Shadow + k, &A, 8);
+    }
+  }
+  for( ; k<Bytes; k++ ){
+    if( Src[k] != Shadow[k] ){
+      markRows(1, k, Stride, Dirty);
+      Shadow[k] = Src[k];
+    }
+  }
+}
+
+#if PORTPACKING_X86
+// ---------------------------------------------------------------
+// SSE kernels
+// Rows narrower than 16 bytes whose element stride divides 16 are
+// moved several rows at a time with a single byte shuffle.
+// ---------------------------------------------------------------
+inline bool isShuffleStride(unsigned Stride){
+  return Stride <= 16 && (16 % Stride) == 0;
+}
+
+// shuffle control expanding 16/Stride packed rows into elements, plus the matching bit mask
+void buildExpand(unsigned Bytes, unsigned Stride, uint8_t Mask,
+                 uint8_t* Ctrl, uint8_t* And){
+  for( unsigned j=0; j<16; j++ ){
+    const unsigned Row = j / Stride;
+    const unsigned B = j % Stride;
+    Ctrl[j] = (B < Bytes) ? static_cast<uint8_t>(Row*Bytes + B) : 0x80;
+    And[j] = (B < Bytes) ? ((B == Bytes-1) ? Mask : 0xff) : 0x00;
+  }
+}
+
+// shuffle control compacting 16/Stride elements into packed rows
+void buildCompact(unsigned Bytes, unsigned Stride, uint8_t* Ctrl){
+  const unsigned Valid = (16 / Stride) * Bytes;
+  for( unsigned j=0; j<16; j++ ){
+    Ctrl[j] = (j < Valid) ? static_cast<uint8_t>((j/Bytes)*Stride + (j%Bytes)) : 0x80;
+  }
+}
+
+// shuffle control placing 4 narrow packed rows into the 4 dword lanes
+void buildLanes(unsigned Bytes, bool Reverse, uint8_t* Ctrl){
+  for( unsigned j=0; j<16; j++ ){
+    const unsigned Lane = j / 4;
+    const unsigned B = j % 4;
+    const unsigned Row = Reverse ? 3-Lane : Lane;
+    Ctrl[j] = (B < Bytes) ? static_cast<uint8_t>(Row*Bytes + B) : 0x80;
+  }
+}
+
+// shuffle control gathering the low Bytes of 4 dword lanes into packed rows
+void buildUnlanes(unsigned Bytes, bool Reverse, uint8_t* Ctrl){
+  for( unsigned j=0; j<16; j++ ){
+    const unsigned Row = j / Bytes;
+    const unsigned Lane = Reverse ? 3-Row : Row;
+    Ctrl[j] = (j < 4*Bytes) ? static_cast<uint8_t>(Lane*4 + (j%Bytes)) : 0x80;
+  }
+}
+
+PORTPACKING_SSE
+void packRowsSSE(const uint8_t* Src, uint8_t* Dst, unsigned Bytes,
+                 unsigned Stride, uint8_t Mask, uint64_t Rows){
+  uint64_t r = 0;
+  if( isShuffleStride(Stride) ){
+    alignas(16) uint8_t Ctrl[16];
+    alignas(16) uint8_t And[16];
+    buildExpand(Bytes, Stride, Mask, Ctrl, And);
+    const __m128i C = _mm_load_si128(reinterpret_cast<const __m128i*>(Ctrl));
+    const __m128i M = _mm_load_si128(reinterpret_cast<const __m128i*>(And));
+    const unsigned RPV = 16 / Stride;
+
+    // the 16 byte loads may extend past the consumed rows; keep them inside Src
+    while( r+RPV <= Rows && (Rows-r)*Bytes >= 16 ){
+      __m128i V = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + (r*Bytes)));
+      V = _mm_and_si128(_mm_shuffle_epi8(V, C), M);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + (r*Stride)), V);
+      r += RPV;
+    }
+  }
+  packRowsScalar(Src + (r*Bytes), Dst + (r*Stride), Bytes, Stride, Mask, Rows-r);
+}
+
+PORTPACKING_SSE
+void unpackRowsSSE(const uint8_t* Src, uint8_t* Dst, unsigned Bytes,
+                   unsigned Stride, uint64_t Rows){
+  uint64_t r = 0;
+  if( isShuffleStride(Stride) ){
+    alignas(16) uint8_t Ctrl[16];
+    buildCompact(Bytes, Stride, Ctrl);
+    const __m128i C = _mm_load_si128(reinterpret_cast<const __m128i*>(Ctrl));
+    const unsigned RPV = 16 / Stride;
+
+    // the 16 byte stores may extend past the produced rows; keep them inside Dst
+    while( r+RPV <= Rows && (Rows-r)*Bytes >= 16 ){
+      const __m128i V = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + (r*Stride)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + (r*Bytes)), _mm_shuffle_epi8(V, C));
+      r += RPV;
+    }
+  }
+  unpackRowsScalar(Src + (r*Stride), Dst + (r*Bytes), Bytes, Stride, Rows-r);
+}
+
+// unchanged 64 byte blocks are skipped after four compares
+PORTPACKING_SSE
+void diffRowsSSE(const uint8_t* Src, uint8_t* Shadow, unsigned Stride,
+                 uint64_t First, uint64_t Bytes, uint64_t* Dirty){
+  uint64_t k = First;
+  for( ; k+64<=Bytes; k+=64 ){
+    uint64_t Diff = 0;
+    for( unsigned v=0; v<4; v++ ){
+      const __m128i A = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + k + v*16));
+      const __m128i B = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Shadow + k + v*16));
+      Diff |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(A, B)) ^ 0xffff) << (v*16);
+    }
+    if( Diff ){
+      markRows(Diff, k, Stride, Dirty);
+      std::memcpy(Shadow + k, Src + k, 64);
+    }
+  }
+  diffRowsScalar(Src, Shadow, Stride, k, Bytes, Dirty);
+}
+
+PORTPACKING_SSE
+void packVecvalSSE(const uint8_t* Src, s_vpi_vecval* Dst, unsigned Bytes,
+                   unsigned Words, uint64_t Rows, bool Reverse){
+  uint64_t r = 0;
+  if( Words == 1 ){
+    // four single-word rows per iteration
+    alignas(16) uint8_t Ctrl[16];
+    buildLanes(Bytes, Reverse, Ctrl);
+    const __m128i C = _mm_load_si128(reinterpret_cast<const __m128i*>(Ctrl));
+    while( r+4 <= Rows && (Rows-r)*Bytes >= 16 ){
+      const __m128i V = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + (r*Bytes))), C);
+      s_vpi_vecval* D = Dst + (Reverse ? Rows-r-4 : r);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(D), _mm_cvtepu32_epi64(V));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(D+2), _mm_cvtepu32_epi64(_mm_srli_si128(V, 8)));
+      r += 4;
+    }
+    packVecvalScalar(Src + (r*Bytes), Dst + (Reverse ? 0 : r), Bytes, Words, Rows-r, Reverse);
+    return;
+  }
+
+  // wide rows: zero-extend pairs of whole words into (aval, bval) pairs
+  const unsigned Full = Bytes / 4;
+  for( ; r<Rows; r++ ){
+    const uint8_t* S = Src + (r*Bytes);
+    s_vpi_vecval* D = Dst + ((Reverse ? Rows-r-1 : r)*Words);
+    unsigned w = 0;
+    for( ; w+2<=Full; w+=2 ){
+      const __m128i V = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(S + w*4));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(D + w), _mm_cvtepu32_epi64(V));
+    }
+    packVecvalRow(S, D, Bytes, w);
+  }
+}
+
+PORTPACKING_SSE
+void unpackVecvalSSE(const s_vpi_vecval* Src, uint8_t* Dst, unsigned Bytes,
+                     unsigned Words, uint64_t Rows, bool Reverse){
+  uint64_t r = 0;
+  if( Words == 1 ){
+    // four single-word rows per iteration
+    alignas(16) uint8_t Ctrl[16];
+    buildUnlanes(Bytes, Reverse, Ctrl);
+    const __m128i C = _mm_load_si128(reinterpret_cast<const __m128i*>(Ctrl));
+    while( r+4 <= Rows && (Rows-r)*Bytes >= 16 ){
+      const s_vpi_vecval* S = Src + (Reverse ? Rows-r-4 : r);
+      const __m128i V0 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(S)),   _MM_SHUFFLE(3,1,2,0));
+      const __m128i V1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(S+2)), _MM_SHUFFLE(3,1,2,0));
+      const __m128i A = _mm_unpacklo_epi64(V0, V1);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + (r*Bytes)), _mm_shuffle_epi8(A, C));
+      r += 4;
+    }
+    unpackVecvalScalar(Src + (Reverse ? 0 : r), Dst + (r*Bytes), Bytes, Words, Rows-r, Reverse);
+    return;
+  }
+
+  // wide rows: extract the avals of pairs of whole words
+  const unsigned Full = Bytes / 4;
+  for( ; r<Rows; r++ ){
+    const s_vpi_vecval* S = Src + ((Reverse ? Rows-r-1 : r)*Words);
+    uint8_t* D = Dst + (r*Bytes);
+    unsigned w = 0;
+    for( ; w+2<=Full; w+=2 ){
+      const __m128i V = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(S + w)), _MM_SHUFFLE(3,1,2,0));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(D + w*4), V);
+    }
+    unpackVecvalRow(S, D, Bytes, w*4);
+  }
+}
+
+// ---------------------------------------------------------------
+// AVX2 kernels
+// The byte shuffles operate per 128-bit lane, so each lane carries
+// the same group of rows as the SSE kernels; narrow vecval rows
+// reuse the SSE kernels.
+// ---------------------------------------------------------------
+PORTPACKING_AVX2
+void packRowsAVX2(const uint8_t* Src, uint8_t* Dst, unsigned Bytes,
+                  unsigned Stride, uint8_t Mask, uint64_t Rows){
+  uint64_t r = 0;
+  if( isShuffleStride(Stride) ){
+    alignas(16) uint8_t Ctrl[16];
+    alignas(16) uint8_t And[16];
+    buildExpand(Bytes, Stride, Mask, Ctrl, And);
+    const __m256i C = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(Ctrl)));
+    const __m256i M = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(And)));
+    const unsigned RPV = 16 / Stride;
+
+    while( r+2*RPV <= Rows && (Rows-r)*Bytes >= RPV*Bytes+16 ){
+      const __m128i Lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + (r*Bytes)));
+      const __m128i Hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + ((r+RPV)*Bytes)));
+      __m256i V = _mm256_inserti128_si256(_mm256_castsi128_si256(Lo), Hi, 1);
+      V = _mm256_and_si256(_mm256_shuffle_epi8(V, C), M);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(Dst + (r*Stride)), V);
+      r += 2*RPV;
+    }
+  }
+  packRowsSSE(Src + (r*Bytes), Dst + (r*Stride), Bytes, Stride, Mask, Rows-r);
+}
+
+PORTPACKING_AVX2
+void unpackRowsAVX2(const uint8_t* Src, uint8_t* Dst, unsigned Bytes,
+                    unsigned Stride, uint64_t Rows){
+  uint64_t r = 0;
+  if( isShuffleStride(Stride) ){
+    alignas(16) uint8_t Ctrl[16];
+    buildCompact(Bytes, Stride, Ctrl);
+    const __m256i C = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(Ctrl)));
+    const unsigned RPV = 16 / Stride;
+
+    // the upper lane is stored over the unused tail of the lower lane
+    while( r+2*RPV <= Rows && (Rows-r)*Bytes >= RPV*Bytes+16 ){
+      const __m256i V = _mm256_shuffle_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src + (r*Stride))), C);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + (r*Bytes)), _mm256_castsi256_si128(V));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + ((r+RPV)*Bytes)), _mm256_extracti128_si256(V, 1));
+      r += 2*RPV;
+    }
+  }
+  unpackRowsSSE(Src + (r*Stride), Dst + (r*Bytes), Bytes, Stride, Rows-r);
+}
+
+PORTPACKING_AVX2
+void diffRowsAVX2(const uint8_t* Src, uint8_t* Shadow, unsigned Stride,
+                  uint64_t First, uint64_t Bytes, uint64_t* Dirty){
+  uint64_t k = First;
+  for( ; k+64<=Bytes; k+=64 ){
+    const __m256i A0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src + k));
+    const __m256i A1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src + k + 32));
+    const __m256i B0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Shadow + k));
+    const __m256i B1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Shadow + k + 32));
+    const uint32_t Eq0 = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(A0, B0)));
+    const uint32_t Eq1 = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(A1, B1)));
+    const uint64_t Diff = ~(static_cast<uint64_t>(Eq1) << 32 | Eq0);
+    if( Diff ){
+      markRows(Diff, k, Stride, Dirty);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(Shadow + k), A0);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(Shadow + k + 32), A1);
+    }
+  }
+  diffRowsScalar(Src, Shadow, Stride, k, Bytes, Dirty);
+}
+
+PORTPACKING_AVX2
+void packVecvalAVX2(const uint8_t* Src, s_vpi_vecval* Dst, unsigned Bytes,
+                    unsigned Words, uint64_t Rows, bool Reverse){
+  if( Words == 1 ){
+    packVecvalSSE(Src, Dst, Bytes, Words, Rows, Reverse);
+    return;
+  }
+
+  // wide rows: zero-extend four whole words at a time
+  const unsigned Full = Bytes / 4;
+  for( uint64_t r=0; r<Rows; r++ ){
+    const uint8_t* S = Src + (r*Bytes);
+    s_vpi_vecval* D = Dst + ((Reverse ? Rows-r-1 : r)*Words);
+    unsigned w = 0;
+    for( ; w+4<=Full; w+=4 ){
+      const __m128i V = _mm_loadu_si128(reinterpret_cast<const __m128i*>(S + w*4));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(D + w), _mm256_cvtepu32_epi64(V));
+    }
+    for( ; w+2<=Full; w+=2 ){
+      const __m128i V = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(S + w*4));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(D + w), _mm_cvtepu32_epi64(V));
+    }
+    packVecvalRow(S, D, Bytes, w);
+  }
+}
+
+PORTPACKING_AVX2
+void unpackVecvalAVX2(const s_vpi_vecval* Src, uint8_t* Dst, unsigned Bytes,
+                      unsigned Words, uint64_t Rows, bool Reverse){
+  if( Words == 1 ){
+    unpackVecvalSSE(Src, Dst, Bytes, Words, Rows, Reverse);
+    return;
+  }
+
+  // wide rows: gather the avals of four whole words at a time
+  const __m256i Even = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  const unsigned Full = Bytes / 4;
+  for( uint64_t r=0; r<Rows; r++ ){
+    const s_vpi_vecval* S = Src + ((Reverse ? Rows-r-1 : r)*Words);
+    uint8_t* D = Dst + (r*Bytes);
+    unsigned w = 0;
+    for( ; w+4<=Full; w+=4 ){
+      const __m256i V = _mm256_permutevar8x32_epi32(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(S + w)), Even);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(D + w*4), _mm256_castsi256_si128(V));
+    }
+    for( ; w+2<=Full; w+=2 ){
+      const __m128i V = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(S + w)), _MM_SHUFFLE(3,1,2,0));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(D + w*4), V);
+    }
+    unpackVecvalRow(S, D, Bytes, w*4);
+  }
+}
+#endif
+
+// ---------------------------------------------------------------
+// Kernel selection
+// ---------------------------------------------------------------
+struct KernelSet {
+  void (*PackRows)(const uint8_t*, uint8_t*, unsigned, unsigned, uint8_t, uint64_t);
+  void (*UnpackRows)(const uint8_t*, uint8_t*, unsigned, unsigned, uint64_t);
+  void (*PackVecval)(const uint8_t*, s_vpi_vecval*, unsigned, unsigned, uint64_t, bool);
+  void (*UnpackVecval)(const s_vpi_vecval*, uint8_t*, unsigned, unsigned, uint64_t, bool);
+  void (*DiffRows)(const uint8_t*, uint8_t*, unsigned, uint64_t, uint64_t, uint64_t*);
+};
+
+const KernelSet ScalarKernels = {
+  packRowsScalar, unpackRowsScalar, packVecvalScalar, unpackVecvalScalar, diffRowsScalar
+};
+#if PORTPACKING_X86
+const KernelSet SSEKernels = {
+  packRowsSSE, unpackRowsSSE, packVecvalSSE, unpackVecvalSSE, diffRowsSSE
+};
+const KernelSet AVX2Kernels = {
+  packRowsAVX2, unpackRowsAVX2, packVecvalAVX2, unpackVecvalAVX2, diffRowsAVX2
+};
+#endif
+
+bool isSupported(Kernel K){
+#if PORTPACKING_X86
+  __builtin_cpu_init();
+#endif
+  switch( K ){
+  case Kernel::SCALAR:
+    return true;
+#if PORTPACKING_X86
+  case Kernel::SSE:
+    return __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.1");
+  case Kernel::AVX2:
+    return __builtin_cpu_supports("avx2");
+#endif
+  default:
+    return false;
+  }
+}
+
+Kernel bestKernel(){
+  if( isSupported(Kernel::AVX2) ) return Kernel::AVX2;
+  if( isSupported(Kernel::SSE) ) return Kernel::SSE;
+  return Kernel::SCALAR;
+}
+
+const KernelSet* kernelSet(Kernel K){
+  switch( K ){
+#if PORTPACKING_X86
+  case Kernel::SSE:  return &SSEKernels;
+  case Kernel::AVX2: return &AVX2Kernels;
+#endif
+  default:           return &ScalarKernels;
+  }
+}
+
+Kernel ActiveKernel = bestKernel();
+const KernelSet* Active = kernelSet(ActiveKernel);
+
+} // anonymous namespace
+
+namespace SST::VerilatorSST::PortPacking {
+
+void packRowsN(const uint8_t* Src, uint8_t* Dst, unsigned Bits, unsigned Stride, uint64_t Rows){
+  const unsigned Bytes = getNumBytes(Bits);
+  const uint8_t Mask = getTopMask(Bits);
+  if( Stride == Bytes && Mask == 0xff ){
+    std::memcpy(Dst, Src, Bytes*Rows);
+    return;
+  }
+  Active->PackRows(Src, Dst, Bytes, Stride, Mask, Rows);
+}
+
+void unpackRowsN(const uint8_t* Src, uint8_t* Dst, unsigned Bits, unsigned Stride, uint64_t Rows){
+  const unsigned Bytes = getNumBytes(Bits);
+  if( Stride == Bytes ){
+    std::memcpy(Dst, Src, Bytes*Rows);
+    return;
+  }
+  Active->UnpackRows(Src, Dst, Bytes, Stride, Rows);
+}
+
+void packVecval(const uint8_t* Src, s_vpi_vecval* Dst, unsigned Bits, uint64_t Rows, bool Reverse){
+  Active->PackVecval(Src, Dst, getNumBytes(Bits), getNumWords(Bits), Rows, Reverse);
+}
+
+void unpackVecval(const s_vpi_vecval* Src, uint8_t* Dst, unsigned Bits, uint64_t Rows, bool Reverse){
+  Active->UnpackVecval(Src, Dst, getNumBytes(Bits), getNumWords(Bits), Rows, Reverse);
+}
+
+void diffRows(const uint8_t* Src, uint8_t* Shadow, unsigned Stride, uint64_t Rows, uint64_t* Dirty){
+  Active->DiffRows(Src, Shadow, Stride, 0, Stride*Rows, Dirty);
+}
+
+Kernel getKernel(){
+  return ActiveKernel;
+}
+
+bool setKernel(Kernel K){
+  if( !isSupported(K) ){
+    return false;
+  }
+  ActiveKernel = K;
+  Active = kernelSet(K);
+  return true;
+}
+
+const char* getKernelName(Kernel K){
+  switch( K ){
+  case Kernel::SSE:  return "sse4.1";
+  case Kernel::AVX2: return "avx2";
+  default:           return "scalar";
+  }
+}
+
+} // namespace SST::VerilatorSST::PortPacking
+
+// EOF
@@ -0,0 +1,103 @@
+//
+// _PortPacking_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _PORTPACKING_H_
+#define _PORTPACKING_H_
+
+#include <cstdint>
+#include <cstring>
+#include "vpi_user.h"
+
+// Packed port data is little-endian; the kernels copy model storage bytes directly
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "PortPacking requires a little-endian host"
+#endif
+
+namespace SST::VerilatorSST::PortPacking {
+
+// A packed port buffer holds Rows rows of getNumBytes(Bits) little-endian bytes each.
+// Model storage holds one element (CData ... VlWide) per row, Stride bytes apart.
+// VPI storage holds one row of getNumWords(Bits) s_vpi_vecval per row.
+
+enum class Kernel : uint8_t {
+  SCALAR = 0,
+  SSE    = 1,   ///< SSSE3 + SSE4.1
+  AVX2   = 2,
+};
+
+/// PortPacking: number of packed bytes per row
+inline unsigned getNumBytes(unsigned Bits) { return (Bits + 7) / 8; }
+
+/// PortPacking: number of 32-bit words per row
+inline unsigned getNumWords(unsigned Bits) { return (Bits + 31) / 32; }
+
+/// PortPacking: mask of the valid bits in the last byte of a row
+inline uint8_t getTopMask(unsigned Bits) {
+  return (Bits % 8) ? static_cast<uint8_t>((1u << (Bits % 8)) - 1) : 0xff;
+}
+
+/// PortPacking: copy Rows packed rows into model elements, clearing bits above the port width
+void packRowsN(const uint8_t* Src, uint8_t* Dst, unsigned Bits, unsigned Stride, uint64_t Rows);
+
+/// PortPacking: copy Rows model elements into packed rows
+void unpackRowsN(const uint8_t* Src, uint8_t* Dst, unsigned Bits, unsigned Stride, uint64_t Rows);
+
+/// PortPacking: packed rows into model elements; single scalar elements are handled inline
+inline void packRows(const uint8_t* Src, void* Dst, unsigned Bits, unsigned Stride, uint64_t Rows) {
+  if( Rows == 1 && Stride <= sizeof(uint64_t) ) {
+    uint64_t V = 0;
+    std::memcpy(&V, Src, getNumBytes(Bits));
+    V &= (Bits < 64) ? ((1ull << Bits) - 1) : ~0ull;
+    std::memcpy(Dst, &V, Stride);
+    return;
+  }
+  packRowsN(Src, static_cast<uint8_t*>(Dst), Bits, Stride, Rows);
+}
+
+/// PortPacking: model elements into packed rows; single scalar elements are handled inline
+inline void unpackRows(const void* Src, uint8_t* Dst, unsigned Bits, unsigned Stride, uint64_t Rows) {
+  if( Rows == 1 ) {
+    std::memcpy(Dst, Src, getNumBytes(Bits));
+    return;
+  }
+  unpackRowsN(static_cast<const uint8_t*>(Src), Dst, Bits, Stride, Rows);
+}
+
+/// PortPacking: packed rows into VPI vector values (bval cleared); Reverse fills rows last to first
+void packVecval(const uint8_t* Src, s_vpi_vecval* Dst, unsigned Bits, uint64_t Rows, bool Reverse);
+
+/// PortPacking: VPI vector values into packed rows; Reverse reads rows last to first
+void unpackVecval(const s_vpi_vecval* Src, uint8_t* Dst, unsigned Bits, uint64_t Rows, bool Reverse);
+
+/// PortPacking: model element size of a port of the given width (CData ... QData, VlWide)
+inline unsigned getStride(unsigned Bits) {
+  if( Bits <= 8 )  return 1;
+  if( Bits <= 16 ) return 2;
+  if( Bits <= 32 ) return 4;
+  if( Bits <= 64 ) return 8;
+  return 4 * getNumWords(Bits);
+}
+
+/// PortPacking: compare Rows model elements against Shadow; sets bit r of Dirty (64 rows per
+/// word) for each row that differs and copies the differing rows into Shadow
+void diffRows(const uint8_t* Src, uint8_t* Shadow, unsigned Stride, uint64_t Rows, uint64_t* Dirty);
+
+/// PortPacking: retrieve the kernel set selected for this host
+Kernel getKernel();
+
+/// PortPacking: force a kernel set; returns false if the host does not support it
+bool setKernel(Kernel K);
+
+/// PortPacking: human readable kernel name
+const char* getKernelName(Kernel K);
+
+} // namespace SST::VerilatorSST::PortPacking
+
+#endif // _PORTPACKING_H_
@@ -0,0 +1,63 @@
+//
+// _Profiler_cpp_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "Profiler.h"
+
+namespace SST::VerilatorSST {
+
+Profiler::Profiler(size_t NumPorts)
+  : Cur{NONE, NO_PORT}, Since(0), Cycle{}, Total{}, PortTicks(NumPorts * NUM_PHASES, 0),
+    NsPerTick(1.0){
+#if defined(__x86_64__) || defined(__i386__)
+  // assumes an invariant TSC; a short spin is enough for sub-percent accuracy
+  const auto T0 = std::chrono::steady_clock::now();
+  const uint64_t C0 = now();
+  auto T1 = T0;
+  while( T1 - T0 < std::chrono::milliseconds(2) ){
+    T1 = std::chrono::steady_clock::now();
+  }
+  const uint64_t C1 = now();
+  const double Ns = std::chrono::duration<double, std::nano>(T1 - T0).count();
+  if( C1 > C0 ){
+    NsPerTick = Ns / static_cast<double>(C1 - C0);
+  }
+#endif
+  Start = std::chrono::steady_clock::now();
+}
+
+std::array<uint64_t, Profiler::NUM_PHASES> Profiler::endCycle(){
+  std::array<uint64_t, NUM_PHASES> Ns;
+  for( unsigned i = 0; i < NUM_PHASES; i++ ){
+    Ns[i] = toNs(Cycle[i]);
+    Cycle[i] = 0;
+  }
+  return Ns;
+}
+
+uint64_t Profiler::elapsedNs() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - Start).count();
+}
+
+const char* Profiler::phaseName(Phase P){
+  switch( P ){
+  case EVAL:  return "eval";
+  case WRITE: return "write";
+  case READ:  return "read";
+  case QUEUE: return "queue";
+  case STATS: return "stats";
+  case LINK:  return "link";
+  default:    return "none";
+  }
+}
+
+} // namespace SST::VerilatorSST
+
+// EOF
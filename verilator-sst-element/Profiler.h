@@ -0,0 +1,145 @@
+//
+// _Profiler_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace SST::VerilatorSST {
+
+/// Host time attributed to the hot-path phases of a subcomponent
+///
+/// Time is exclusive: a phase entered inside another one (the eval run by a
+/// port write, say) stops the outer phase's clock until it returns. Time
+/// outside any phase is not counted.
+class Profiler {
+public:
+  /// Profiled phases
+  enum Phase : unsigned {
+    EVAL  = 0,   ///< Phase: Top->eval()
+    WRITE = 1,   ///< Phase: port writes, including packing
+    READ  = 2,   ///< Phase: port reads, including unpacking
+    QUEUE = 3,   ///< Phase: write queue polling
+    STATS = 4,   ///< Phase: statistic updates
+    LINK  = 5,   ///< Phase: link event handling
+    NUM_PHASES = 6,
+    NONE  = NUM_PHASES,
+  };
+
+  /// Port index used for phases not attributed to a port
+  static constexpr uint32_t NO_PORT = UINT32_MAX;
+
+  /// Phase and port being timed
+  struct State {
+    Phase P;
+    uint32_t Port;
+  };
+
+  /// Times the enclosing block as Phase; the disabled variant compiles to nothing
+  template<bool Enabled>
+  class Scope {
+  public:
+    Scope(Profiler* Prof, Phase P, uint32_t Port) : Prof(Prof), Prev(Prof->enter(P, Port)){}
+    ~Scope(){ Prof->leave(Prev); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  private:
+    Profiler* Prof;
+    State Prev;
+  };
+
+  /// Calibrates the timestamp counter against steady_clock
+  explicit Profiler(size_t NumPorts);
+
+  /// Raw timestamp: the TSC on x86, steady_clock nanoseconds elsewhere
+  static uint64_t now(){
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+
+  /// Start timing Phase; returns the state to restore when it ends
+  State enter(Phase P, uint32_t Port){
+    charge(now());
+    const State Prev = Cur;
+    Cur = {P, Port};
+    return Prev;
+  }
+
+  /// Stop timing the current phase and resume Prev
+  void leave(State Prev){
+    charge(now());
+    Cur = Prev;
+  }
+
+  /// Nanoseconds spent in each phase since the last call; resets the per-cycle counters
+  std::array<uint64_t, NUM_PHASES> endCycle();
+
+  /// Total nanoseconds spent in Phase
+  uint64_t totalNs(Phase P) const { return toNs(Total[P]); }
+
+  /// Total nanoseconds attributed to Port in Phase
+  uint64_t portNs(uint32_t Port, Phase P) const { return toNs(PortTicks[Port * NUM_PHASES + P]); }
+
+  /// Host nanoseconds since the profiler was created
+  uint64_t elapsedNs() const;
+
+  /// Phase name used for statistics and the finish report
+  static const char* phaseName(Phase P);
+
+private:
+  void charge(uint64_t Now){
+    if( Cur.P != NONE ){
+      const uint64_t Delta = Now - Since;
+      Cycle[Cur.P] += Delta;
+      Total[Cur.P] += Delta;
+      if( Cur.Port != NO_PORT ){
+        PortTicks[Cur.Port * NUM_PHASES + Cur.P] += Delta;
+      }
+    }
+    Since = Now;
+  }
+
+  uint64_t toNs(uint64_t Ticks) const { return static_cast<uint64_t>(Ticks * NsPerTick); }
+
+  State Cur;                                 ///< Profiler: phase being timed
+  uint64_t Since;                            ///< Profiler: timestamp of the last phase change
+  std::array<uint64_t, NUM_PHASES> Cycle;    ///< Profiler: ticks per phase this cycle
+  std::array<uint64_t, NUM_PHASES> Total;    ///< Profiler: ticks per phase
+  std::vector<uint64_t> PortTicks;           ///< Profiler: ticks per port and phase
+  double NsPerTick;                          ///< Profiler: timestamp calibration
+  std::chrono::steady_clock::time_point Start; ///< Profiler: creation time
+};
+
+/// Disabled scope; builds without PROFILE carry no timing code
+template<>
+class Profiler::Scope<false> {
+public:
+  Scope(Profiler*, Phase, uint32_t){}
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+};
+
+} // namespace SST::VerilatorSST
+
+#endif  // _PROFILER_H_
+
+// EOF
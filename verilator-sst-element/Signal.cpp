@@ -24,50 +24,73 @@ uint32_t Signal::calculateNumWords(uint32_t nBits){
   return words;
 }
 
-Signal::Signal(uint32_t nBits, std::vector<uint8_t> initVal) : Signal(nBits,1,initVal,false){}
+s_vpi_vecval * Signal::allocate(uint64_t count){
+  void * mem = ::operator new[](count*sizeof(s_vpi_vecval), std::align_val_t(SIGNAL_ALIGN));
+  std::memset(mem, 0, count*sizeof(s_vpi_vecval));
+  return static_cast<s_vpi_vecval *>(mem);
+}
 
-Signal::Signal(uint32_t nBits, uint64_t depth, const std::vector<uint8_t>& initVal, bool descending):
-  depth(depth), 
-  nBits(nBits){
-  validate(nBits,depth);
+void Signal::release(s_vpi_vecval * storage){
+  if(storage){
+    ::operator delete[](storage, std::align_val_t(SIGNAL_ALIGN));
+  }
+}
 
-  storage = new s_vpi_value[depth];
+Signal::Signal(uint32_t nBits, uint64_t depth):
+  nBits(nBits),
+  depth(depth),
+  words(0),
+  storage(nullptr){
+  validate(nBits,depth);
+  words = calculateNumWords(nBits);
+  storage = allocate(words*depth);
+}
 
-  const auto words = calculateNumWords(nBits);
-  const auto bytes = calculateNumBytes(nBits);
+Signal::Signal(uint32_t nBits, std::vector<uint8_t> initVal) : Signal(nBits,1,initVal,false){}
 
-  const auto buf = uint8ArrToUint32Arr(initVal,bytes,depth);
-    
-  for(auto i =0;i<depth;i++){
-    p_vpi_value row = descending ? &storage[depth-i-1] : &storage[i];
-    row->format = SIGNAL_VPI_FORMAT;
-    row->value.vector = new s_vpi_vecval[words];
-    for(int k=0;k<words;k++){
-      row->value.vector[k].aval = buf[(i*words)+k];
-      row->value.vector[k].bval = 0UL;
-    }
+Signal::Signal(uint32_t nBits, uint64_t depth, const std::vector<uint8_t>& initVal, bool descending):
+  Signal(nBits, depth){
+  const auto packedBytes = calculateNumBytes(nBits)*depth;
+  if(initVal.size() >= packedBytes){
+    pack(initVal.data(), descending);
+    return;
   }
+
+  // short initial values are zero extended
+  std::vector<uint8_t> padded(initVal);
+  padded.resize(packedBytes, 0);
+  pack(padded.data(), descending);
 }
 
-Signal::Signal(uint32_t nBits, uint64_t depth, p_vpi_value storage):
+Signal::Signal(uint32_t nBits, uint64_t depth, s_vpi_vecval * storage):
   nBits(nBits),
   depth(depth),
+  words(calculateNumWords(nBits)),
   storage(storage){
   validate(nBits,depth);
 }
 
-Signal::Signal(const Signal& other) : Signal(other.nBits, other.depth, other.getUIntVector(false), false){}
+Signal::Signal(const Signal& other) : Signal(other.nBits, other.depth){
+  std::memcpy(storage, other.storage, words*depth*sizeof(s_vpi_vecval));
+}
+
+Signal::Signal(Signal&& other) noexcept:
+  nBits(other.nBits),
+  depth(other.depth),
+  words(other.words),
+  storage(other.storage){
+  other.storage = nullptr;
+  other.depth = 0;
+}
 
 Signal::~Signal(){
-  for(auto i=0;i<depth;i++){
-    delete[] storage[i].value.vector;
-  }
-  delete[] storage;
+  release(storage);
 }
 
 void Signal::swap(Signal& first, Signal& second){
   std::swap(first.nBits, second.nBits);
   std::swap(first.depth, second.depth);
+  std::swap(first.words, second.words);
   std::swap(first.storage, second.storage);
 }
 
@@ -84,15 +107,43 @@ uint64_t Signal::getDepth() const{
   return depth;
 }
 
+uint32_t Signal::getNumWords() const{
+  return words;
+}
+
+s_vpi_vecval * Signal::getRow(uint64_t row){
+  assert(row < depth && "depth out of range");
+  return storage + (row*words);
+}
+
+const s_vpi_vecval * Signal::getRow(uint64_t row) const{
+  assert(row < depth && "depth out of range");
+  return storage + (row*words);
+}
+
+void Signal::setRow(uint64_t row, const s_vpi_vecval * src){
+  std::memcpy(getRow(row), src, words*sizeof(s_vpi_vecval));
+}
+
+void Signal::pack(const uint8_t * src, bool descending){
+  PortPacking::packVecval(src, storage, nBits, depth, descending);
+}
+
+void Signal::unpack(uint8_t * dst, bool reverse) const{
+  PortPacking::unpackVecval(storage, dst, nBits, depth, reverse);
+}
+
 s_vpi_value Signal::getVpiValue(uint64_t depth) const{
   assert(depth < this->depth && "depth out of range");
-  s_vpi_value ret = storage[depth];
+  s_vpi_value ret;
+  ret.format = SIGNAL_VPI_FORMAT;
+  ret.value.vector = const_cast<s_vpi_vecval *>(getRow(depth));
 
   return ret;
 }
 
 uint8_t Signal::getUIntScalar() const{
-  uint8_t bit = storage[0].value.vector[0].aval & 1;
+  uint8_t bit = storage[0].aval & 1;
   return bit;
 }
 
@@ -100,31 +151,15 @@ uint8_t Signal::getUIntScalar() const{
 const std::vector<uint8_t> Signal::getUIntArray(uint64_t depth) const{
   assert(depth < this->depth && "depth out of range");
 
-  const auto words = calculateNumWords(nBits);
-  const auto bytes = calculateNumBytes(nBits);
-  auto buf = std::vector<uint32_t>(words);
-  for(auto i=0;i<words;i++){
-    buf[i] = storage[depth].value.vector[i].aval;
-  }
-
-  const std::vector<uint8_t>& ret = uint32ArrToUint8Arr(buf,bytes,1);
+  std::vector<uint8_t> ret(calculateNumBytes(nBits));
+  PortPacking::unpackVecval(getRow(depth), ret.data(), nBits, 1, false);
 
   return ret;
 }
 
 const std::vector<uint8_t> Signal::getUIntVector(bool reverse) const{
-  const auto words = calculateNumWords(nBits);
-  const auto bytes = calculateNumBytes(nBits);
-
-  auto buf = std::vector<uint32_t>(words*depth);
-  for(auto i=0;i<depth;i++){
-    auto row = reverse ? storage[depth-i-1] : storage[i];
-    for(auto j=0;j<words;j++){
-      buf[(i*words)+j] = row.value.vector[j].aval;
-    }
-  }
-
-  const std::vector<uint8_t>& ret = uint32ArrToUint8Arr(buf, bytes, depth);
+  std::vector<uint8_t> ret(calculateNumBytes(nBits)*depth);
+  unpack(ret.data(), reverse);
 
   return ret;
 }
@@ -132,19 +167,10 @@ const std::vector<uint8_t> Signal::getUIntVector(bool reverse) const{
 const std::vector<uint8_t> Signal::uint32ArrToUint8Arr(const std::vector<uint32_t>& src, const uint32_t bytesPerRow, const uint64_t rows){
   const auto wordsPerRow = calculateNumWords(bytesPerRow*8);
   auto buf = std::vector<uint8_t>(bytesPerRow*rows);
-  for(auto i=0;i<rows;i++){
-    auto rowBuf = std::vector<uint8_t>(bytesPerRow);
-        
-    for(auto j=0;j<wordsPerRow;j++){
-      for(auto k=0;k<sizeof(uint32_t);k++){
-        rowBuf[(j*sizeof(uint32_t))+k] = reinterpret_cast<const uint8_t*>(&src[(i*wordsPerRow)+j])[k];
-      }
-    }
-
-    for(auto j=0;j<bytesPerRow;j++){
-      buf[(i*bytesPerRow)+j] = rowBuf[j];
+  for(uint64_t i=0;i<rows;i++){
+    for(uint32_t k=0;k<bytesPerRow;k++){
+      buf[(i*bytesPerRow)+k] = (src[(i*wordsPerRow)+(k/sizeof(uint32_t))] >> ((k%sizeof(uint32_t))*8)) & 255;
     }
-
   }
 
   return buf;
@@ -153,16 +179,12 @@ const std::vector<uint8_t> Signal::uint32ArrToUint8Arr(const std::vector<uint32_
 const std::vector<uint32_t> Signal::uint8ArrToUint32Arr(const std::vector<uint8_t>& src, const uint32_t bytesPerRow, const uint64_t rows){
   const auto wordsPerRow = calculateNumWords(bytesPerRow*8);
   auto buf = std::vector<uint32_t>(wordsPerRow*rows);
+  const auto avail = std::min<uint64_t>(src.size(), bytesPerRow*rows);
 
-  for(auto i = 0; i < rows; i++){
-    auto rowBuf = std::vector<uint32_t>(wordsPerRow);
-    for(auto k = 0; k < bytesPerRow; k++){
-      reinterpret_cast<uint8_t*>(rowBuf.data())[k] = src[(i*bytesPerRow)+k];
-    }
-    uint32_t mask = (bytesPerRow < 4) ? (1 << (bytesPerRow*8)) - 1 : 0xffffffff;
-    for(auto j = 0; j < wordsPerRow; j++){
-      buf[(i*wordsPerRow)+j] = rowBuf[j] & mask;
-    }
+  for(uint64_t i=0;i<avail;i++){
+    const uint64_t row = i/bytesPerRow;
+    const uint32_t k = i%bytesPerRow;
+    buf[(row*wordsPerRow)+(k/sizeof(uint32_t))] |= static_cast<uint32_t>(src[i]) << ((k%sizeof(uint32_t))*8);
   }
 
   return buf;
@@ -176,35 +198,27 @@ void Signal::validate(uint32_t nBits, uint64_t depth){
 
 //SIGNAL FACTORY
 
-SignalFactory::SignalFactory(uint32_t nBits, uint64_t depth): 
+SignalFactory::SignalFactory(uint32_t nBits, uint64_t depth):
 bits(nBits),
 words(Signal::calculateNumWords(bits)),
 depth(depth){
   assert(depth > 0 && "depth must be positive");
-  storage = new s_vpi_value[depth];
+  storage = Signal::allocate(words*depth);
 }
 
 SignalFactory::SignalFactory() : SignalFactory(1,1){};
 SignalFactory::~SignalFactory(){
-  if(!storage){
-    return;
-  }
-
-  for(auto i=0;i<depth;i++){
-    delete[] storage[i].value.vector;
-  }
-  delete[] storage;
+  Signal::release(storage);
 }
 
 Signal * SignalFactory::operator()(const s_vpi_value &row){
+  assert(storage && "cannot add more rows");
   assert(nextRow < depth && "cannot add more rows");
   assert(row.format == SIGNAL_VPI_FORMAT && "all rows must be SIGNAL_VPI_FORMAT");
 
-  storage[nextRow].format = SIGNAL_VPI_FORMAT;
-  storage[nextRow].value.vector = new s_vpi_vecval[words];
-  std::memcpy(storage[nextRow].value.vector, row.value.vector, words*sizeof(uint32_t)*2); // *2 to account for aval and bval
-    
-  nextRow++;  
+  std::memcpy(storage + (nextRow*words), row.value.vector, words*sizeof(s_vpi_vecval));
+
+  nextRow++;
 
   if(nextRow == depth){
     Signal * signal = new Signal(bits,depth,storage);
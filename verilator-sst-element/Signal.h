@@ -16,14 +16,17 @@
 #include <cassert>
 #include <cstring>
 #include <memory>
+#include <new>
 #include <vector>
 #include "vpi_user.h"
 #include "verilatedos.h"
+#include "PortPacking.h"
 
 #define SIGNAL_VPI_FORMAT vpiVectorVal
 #define SIGNAL_LOW (uint64_t) 0
 #define SIGNAL_HIGH (uint64_t) 1
 #define SIGNAL_BITS_MAX VL_VALUE_STRING_MAX_WORDS * VL_EDATASIZE * 8
+#define SIGNAL_ALIGN 64
 
 namespace SST::VerilatorSST {
 
@@ -36,16 +39,23 @@ class Signal {
   //private members
     uint32_t nBits;
     uint64_t depth;
-    p_vpi_value storage;
+    uint32_t words;
+    s_vpi_vecval * storage;   // depth rows of words, contiguous and SIGNAL_ALIGN aligned
 
     //construction validators
     void validate(uint32_t nBits, uint64_t depth);
 
+    //storage management
+    static s_vpi_vecval * allocate(uint64_t count);
+    static void release(s_vpi_vecval * storage);
+
     //constructors and destructors
-    Signal(uint32_t nBits, uint64_t depth, p_vpi_value storage);
+    Signal(uint32_t nBits, uint64_t depth, s_vpi_vecval * storage);
 
   public:
+    Signal(uint32_t nBits, uint64_t depth);
     Signal(const Signal& other);
+    Signal(Signal&& other) noexcept;
     Signal(uint32_t nBits, std::vector<uint8_t> init_val);
     Signal(uint32_t nBits, uint64_t depth, const std::vector<uint8_t>& init_val, bool descending);
     ~Signal();
@@ -54,6 +64,16 @@ class Signal {
     //private member accessors
     uint32_t getNumBits() const;
     uint64_t getDepth() const;
+    uint32_t getNumWords() const;
+
+    //row views into the storage
+    s_vpi_vecval * getRow(uint64_t row);
+    const s_vpi_vecval * getRow(uint64_t row) const;
+    void setRow(uint64_t row, const s_vpi_vecval * src);
+
+    //byte packing; each row occupies calculateNumBytes(nBits) bytes of the packed buffer
+    void pack(const uint8_t * src, bool descending);
+    void unpack(uint8_t * dst, bool reverse) const;
 
     //storage representation accessors
     uint8_t getUIntScalar() const;
@@ -64,7 +84,7 @@ class Signal {
 
     //helper functions
     void swap(Signal& first, Signal& second);
-    
+
     static uint32_t calculateNumBytes(uint32_t nBits);
     static uint32_t calculateNumWords(uint32_t nBits);
     static const std::vector<uint32_t> uint8ArrToUint32Arr(const std::vector<uint8_t>& src, const uint32_t size, const uint64_t rows);
@@ -72,12 +92,12 @@ class Signal {
 };
 
 class SignalFactory {
-  private: 
+  private:
     uint32_t bits = 0;
     uint32_t words = 0;
     uint64_t depth = 0;
     uint64_t nextRow = 0;
-    p_vpi_value storage;
+    s_vpi_vecval * storage;
 
   public:
     SignalFactory(uint32_t nBits, uint64_t depth);
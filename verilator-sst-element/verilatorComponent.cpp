@@ -39,10 +39,13 @@ VerilatorComponent::VerilatorComponent(SST::ComponentId_t id,
 VerilatorComponent::~VerilatorComponent(){
 }
 
+// the core does not run the lifecycle hooks of subcomponents; forward them
 void VerilatorComponent::setup(){
+  model->setup();
 }
 
 void VerilatorComponent::finish(){
+  model->finish();
 }
 
 void VerilatorComponent::init( unsigned int phase ){
@@ -50,7 +53,8 @@ void VerilatorComponent::init( unsigned int phase ){
 }
 
 bool VerilatorComponent::clock(SST::Cycle_t currentCycle){
-  if( currentCycle > NumCycles ){
+  // end at numCycles or as soon as the model executes $finish
+  if( currentCycle > NumCycles || model->isFinished() ){
     primaryComponentOKToEndSim();
     return true;
   }
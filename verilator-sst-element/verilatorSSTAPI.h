@@ -53,6 +53,7 @@ enum class VPortType : uint8_t {
   V_INOUT  = 0b00000011,  /// VPortType: inout port
   V_INPUT  = 0b00000010,  /// VPortType: input port
   V_OUTPUT = 0b00000001,  /// VPortType: output port
+  V_PROBE  = 0b00000111,  /// VPortType: readable and writable internal signal (PROBES)
 };
 
 #define V_NAME            0
@@ -63,17 +64,33 @@ enum class VPortType : uint8_t {
 #define V_READFUNC        5
 #define V_WRITE_STAT      6
 #define V_READ_STAT       7
+#define V_DATAFUNC        8
 
-typedef std::pair<std::string,
+// Index of a port in the subcomponent port table; obtained via resolvePort
+typedef unsigned PortHandle;
+
+typedef std::pair<PortHandle,
                   uint64_t> PortReset;
 
 // Struct to hold info for synchronous delayed writes 
 struct QueueEntry {
-  std::string PortName;
+  PortHandle Port;
   uint64_t AtTick;
+  uint64_t Seq;     // insertion order; keeps writes at the same tick in FIFO order
   std::vector<uint8_t> Packet;
-  QueueEntry(std::string PortName, uint64_t AtTick, std::vector<uint8_t> Packet)
-      : PortName(PortName), AtTick(AtTick), Packet(Packet) { }
+  uint32_t FirstRow;  // first row written
+  uint32_t RowCount;  // rows held by Packet
+  QueueEntry(PortHandle Port, uint64_t AtTick, uint64_t Seq, std::vector<uint8_t> Packet,
+             uint32_t FirstRow, uint32_t RowCount)
+      : Port(Port), AtTick(AtTick), Seq(Seq), Packet(std::move(Packet)),
+        FirstRow(FirstRow), RowCount(RowCount) { }
+};
+
+// Heap ordering for QueueEntry; the earliest (AtTick, Seq) is on top
+struct QueueEntryLater {
+  bool operator()(const QueueEntry& A, const QueueEntry& B) const {
+    return (A.AtTick != B.AtTick) ? (A.AtTick > B.AtTick) : (A.Seq > B.Seq);
+  }
 };
 
 
@@ -82,8 +99,12 @@ struct QueueEntry {
 // ---------------------------------------------------------------
 
 enum class PortEventAction : uint8_t {
-  WRITE = 0b00000000,
-  READ  = 0b00000001
+  WRITE       = 0b00000000,
+  READ        = 0b00000001,
+  SUBSCRIBE   = 0b00000010,   ///< request (AtTick = interval) or change notification (AtTick = sample tick)
+  UNSUBSCRIBE = 0b00000011,
+  CHANGES     = 0b00000100    ///< request the rows changed since the last request; the reply
+                              ///< packet holds [uint32_t row (little endian)][row bytes] pairs
 };
 
 // Event used to send writes/reads to exposed ports across links
@@ -91,26 +112,37 @@ class PortEvent : public SST::Event{
 public:
   /// PortEvent: default constructor
   explicit PortEvent()
-    : Event(), AtTick(0x00ull), Action(PortEventAction::READ) {
+    : Event(), AtTick(0x00ull), Action(PortEventAction::READ), FirstRow(0), RowCount(0) {
   }
 
   /// PortEvent: overloaded constructor
   explicit PortEvent(uint64_t Tick, PortEventAction Action)
-    : Event(), AtTick(Tick), Action(Action) {
+    : Event(), AtTick(Tick), Action(Action), FirstRow(0), RowCount(0) {
   }
 
   /// PortEvent: write constructor w/ data payload
   explicit PortEvent(std::vector<uint8_t> P)
-    : Event(), AtTick(0x00ull), Action(PortEventAction::WRITE) {
-    std::copy(P.begin(), P.end(),
-              std::back_inserter(Packet));
+    : Event(), Packet(std::move(P)), AtTick(0x00ull), Action(PortEventAction::WRITE),
+      FirstRow(0), RowCount(0) {
   }
 
   /// PortEvent: delayed write constructor (to occur at Tick)
   explicit PortEvent(std::vector<uint8_t> P, uint64_t Tick)
-    : Event(), AtTick(Tick), Action(PortEventAction::WRITE) {
-    std::copy(P.begin(), P.end(),
-              std::back_inserter(Packet));
+    : Event(), Packet(std::move(P)), AtTick(Tick), Action(PortEventAction::WRITE),
+      FirstRow(0), RowCount(0) {
+  }
+
+  /// PortEvent: payload constructor with an explicit action
+  explicit PortEvent(std::vector<uint8_t> P, uint64_t Tick, PortEventAction Action)
+    : Event(), Packet(std::move(P)), AtTick(Tick), Action(Action), FirstRow(0), RowCount(0) {
+  }
+
+  /// PortEvent: row range constructor; addresses Count rows of an array port starting at First.
+  /// WRITE carries Count rows of payload, READ requests carry none and are answered with a
+  /// WRITE event for the same range
+  explicit PortEvent(std::vector<uint8_t> P, uint64_t Tick, PortEventAction Action,
+                     uint32_t First, uint32_t Count)
+    : Event(), Packet(std::move(P)), AtTick(Tick), Action(Action), FirstRow(First), RowCount(Count) {
   }
 
   /// PortEvent: virtual clone function
@@ -126,7 +158,13 @@ public:
   uint64_t getAtTick() const { return AtTick; }
 
   /// PortEvent: retrieve the packet payload
-  const std::vector<uint8_t> getPacket() const { return Packet; }
+  const std::vector<uint8_t>& getPacket() const { return Packet; }
+
+  /// PortEvent: retrieve the first row of a row range event
+  uint32_t getFirstRow() const { return FirstRow; }
+
+  /// PortEvent: retrieve the number of rows of a row range event; 0 addresses the whole port
+  uint32_t getRowCount() const { return RowCount; }
 
   /// PortEvent: set the target clock tick
   void setAtTick(uint64_t T) { AtTick = T; }
@@ -141,6 +179,8 @@ private:
   std::vector<uint8_t> Packet;  /// event packet
   uint64_t AtTick;              /// event at clock tick
   PortEventAction Action;       /// event action
+  uint32_t FirstRow;            /// first row of a row range
+  uint32_t RowCount;            /// rows in the range; 0 for the whole port
 
 public:
   // PortEvent: event serializer
@@ -149,12 +189,105 @@ public:
     ser & Packet;
     ser & AtTick;
     ser & Action;
+    ser & FirstRow;
+    ser & RowCount;
   }
 
   // PortEvent: implements the nic serialization
   ImplementSerializable(SST::VerilatorSST::PortEvent);
 };
 
+// ---------------------------------------------------------------
+// PortBatchEvent
+// ---------------------------------------------------------------
+
+// Event used to send several port writes/reads across a single "bus" link.
+// Operations address ports by PortHandle and are applied in order; the
+// response carries one READ entry (with data) per requested read, in
+// request order. During init the subcomponent sends a directory batch
+// whose names list the ports by handle.
+class PortBatchEvent : public SST::Event{
+public:
+  /// PortBatchEvent: default constructor
+  explicit PortBatchEvent() : Event() {
+  }
+
+  /// PortBatchEvent: virtual clone function
+  virtual Event* clone(void) override{
+    PortBatchEvent *pe = new PortBatchEvent(*this);
+    return pe;
+  }
+
+  /// PortBatchEvent: append a write of Len bytes from Buf; a nonzero Tick delays it to that tick
+  void addWrite(PortHandle Port, const uint8_t* Buf, size_t Len, uint64_t Tick = 0){
+    std::copy(Buf, Buf+Len, addOp(Port, PortEventAction::WRITE, Tick, Len));
+  }
+
+  /// PortBatchEvent: append a read request
+  void addRead(PortHandle Port){
+    addOp(Port, PortEventAction::READ, 0, 0);
+  }
+
+  /// PortBatchEvent: append an operation with Len payload bytes; returns the payload storage
+  uint8_t* addOp(PortHandle Port, PortEventAction Action, uint64_t Tick, size_t Len){
+    Ports.push_back(Port);
+    Actions.push_back(static_cast<uint8_t>(Action));
+    Ticks.push_back(Tick);
+    Offsets.push_back(Data.size());
+    Data.resize(Data.size() + Len);
+    return Data.data() + Offsets.back();
+  }
+
+  /// PortBatchEvent: append a port name to the directory
+  void addName(const std::string& Name){ Names.push_back(Name); }
+
+  /// PortBatchEvent: retrieve the number of operations
+  size_t getNumOps() const { return Ports.size(); }
+
+  /// PortBatchEvent: retrieve the port handle of operation Op
+  PortHandle getPort(size_t Op) const { return Ports[Op]; }
+
+  /// PortBatchEvent: retrieve the action of operation Op
+  PortEventAction getAction(size_t Op) const { return static_cast<PortEventAction>(Actions[Op]); }
+
+  /// PortBatchEvent: retrieve the target clock tick of operation Op
+  uint64_t getAtTick(size_t Op) const { return Ticks[Op]; }
+
+  /// PortBatchEvent: retrieve the payload of operation Op
+  const uint8_t* getData(size_t Op) const { return Data.data() + Offsets[Op]; }
+
+  /// PortBatchEvent: retrieve the payload length of operation Op
+  size_t getDataLen(size_t Op) const {
+    return ((Op+1 < Offsets.size()) ? Offsets[Op+1] : Data.size()) - Offsets[Op];
+  }
+
+  /// PortBatchEvent: retrieve the port directory; names are indexed by port handle
+  const std::vector<std::string>& getNames() const { return Names; }
+
+private:
+  std::vector<PortHandle> Ports;  /// target port of each operation
+  std::vector<uint8_t> Actions;   /// PortEventAction of each operation
+  std::vector<uint64_t> Ticks;    /// target clock tick of each operation
+  std::vector<uint64_t> Offsets;  /// start of each operation's payload in Data
+  std::vector<uint8_t> Data;      /// concatenated payloads
+  std::vector<std::string> Names; /// port directory
+
+public:
+  // PortBatchEvent: event serializer
+  void serialize_order(SST::Core::Serialization::serializer &ser) override{
+    Event::serialize_order(ser);
+    ser & Ports;
+    ser & Actions;
+    ser & Ticks;
+    ser & Offsets;
+    ser & Data;
+    ser & Names;
+  }
+
+  // PortBatchEvent: implements the nic serialization
+  ImplementSerializable(SST::VerilatorSST::PortBatchEvent);
+};
+
 // ---------------------------------------------------------------
 // SignalHelper
 // ---------------------------------------------------------------
@@ -224,8 +357,20 @@ public:
   /// VerilatorSSTBase: get the current clock tick from verilator
   virtual uint64_t getCurrentTick() = 0;
 
+  /// VerilatorSSTBase: determine if the model has executed $finish
+  virtual bool isFinished() = 0;
+
+  /// VerilatorSSTBase: save the model state, pending writes and current tick to a snapshot file
+  virtual void saveSnapshot(const std::string& Path) = 0;
+
+  /// VerilatorSSTBase: restore the model state, pending writes and current tick from a snapshot file
+  virtual void restoreSnapshot(const std::string& Path) = 0;
+
   /// VerilatorSSTBase: determine if the target port is valid
-  virtual bool isNamedPort(std::string PortName) = 0;
+  virtual bool isNamedPort(const std::string& PortName) = 0;
+
+  /// VerilatorSSTBase: resolve the target port name to a port handle
+  virtual PortHandle resolvePort(const std::string& PortName) = 0;
 
   /// VerilatorSSTBase: retrieve the number of configured ports
   virtual unsigned getNumPorts() = 0;
@@ -234,28 +379,89 @@ public:
   virtual const std::vector<std::string> getPortsNames() = 0;
 
   /// VerilatorSSTBase: retrieve the port type of the target port
-  virtual bool getPortType(std::string PortName, VPortType& direction) = 0;
+  virtual bool getPortType(const std::string& PortName, VPortType& direction) = 0;
+
+  /// VerilatorSSTBase: retrieve the port type of the target port handle
+  virtual bool getPortType(PortHandle Handle, VPortType& direction) = 0;
 
   /// VerilatorSSTBase: retrieve the port width of the target port
-  virtual bool getPortWidth(std::string PortName, unsigned& Width) = 0;
+  virtual bool getPortWidth(const std::string& PortName, unsigned& Width) = 0;
+
+  /// VerilatorSSTBase: retrieve the port width of the target port handle
+  virtual bool getPortWidth(PortHandle Handle, unsigned& Width) = 0;
 
   /// VerilatorSSTBase: retrieve the port depth of the target port
-  virtual bool getPortDepth(std::string PortName, unsigned& Depth) = 0;
+  virtual bool getPortDepth(const std::string& PortName, unsigned& Depth) = 0;
+
+  /// VerilatorSSTBase: retrieve the port depth of the target port handle
+  virtual bool getPortDepth(PortHandle Handle, unsigned& Depth) = 0;
+
+  /// VerilatorSSTBase: retrieve the number of packet bytes (width bytes * depth) of the target port handle
+  virtual unsigned getPortBytes(PortHandle Handle) = 0;
 
   /// VerilatorSSTBase: retrieve the port reset value of the target port
-  virtual bool getResetVal(std::string PortName, uint64_t& Val) = 0;
+  virtual bool getResetVal(const std::string& PortName, uint64_t& Val) = 0;
 
   /// VerilatorSSTBase: write to the target port
-  virtual void writePort(std::string portName,
+  virtual void writePort(const std::string& portName,
                          const std::vector<uint8_t>& packet) = 0;
 
+  /// VerilatorSSTBase: write to the target port handle
+  virtual void writePort(PortHandle Handle,
+                         const std::vector<uint8_t>& packet) = 0;
+
+  /// VerilatorSSTBase: write Len bytes from Buf to the target port handle
+  virtual void writePort(PortHandle Handle,
+                         const uint8_t* Buf, size_t Len) = 0;
+
   /// VerilatorSSTBase: write to the target port at the target clock cycle
-  virtual void writePortAtTick(std::string portName,
+  virtual void writePortAtTick(const std::string& portName,
+                               const std::vector<uint8_t>& packet,
+                               uint64_t tick) = 0;
+
+  /// VerilatorSSTBase: write to the target port handle at the target clock cycle
+  virtual void writePortAtTick(PortHandle Handle,
                                const std::vector<uint8_t>& packet,
                                uint64_t tick) = 0;
 
   /// VerilatorSSTBase: read from the target port
-  virtual std::vector<uint8_t> readPort(std::string portName) = 0;
+  virtual std::vector<uint8_t> readPort(const std::string& portName) = 0;
+
+  /// VerilatorSSTBase: read from the target port handle
+  virtual std::vector<uint8_t> readPort(PortHandle Handle) = 0;
+
+  /// VerilatorSSTBase: read from the target port handle into Buf (at least getPortBytes bytes)
+  virtual void readPortInto(PortHandle Handle, uint8_t* Buf, size_t Len) = 0;
+
+  /// VerilatorSSTBase: write Count rows starting at FirstRow of the target port handle from Buf (Len bytes)
+  virtual void writePortRows(PortHandle Handle, unsigned FirstRow, unsigned Count,
+                             const uint8_t* Buf, size_t Len) = 0;
+
+  /// VerilatorSSTBase: write Count rows starting at FirstRow of the target port handle at the target clock cycle
+  virtual void writePortRowsAtTick(PortHandle Handle, unsigned FirstRow, unsigned Count,
+                                   const std::vector<uint8_t>& packet,
+                                   uint64_t tick) = 0;
+
+  /// VerilatorSSTBase: read Count rows starting at FirstRow of the target port handle
+  virtual std::vector<uint8_t> readPortRows(PortHandle Handle, unsigned FirstRow, unsigned Count) = 0;
+
+  /// VerilatorSSTBase: read Count rows starting at FirstRow of the target port handle into Buf (Len bytes)
+  virtual void readPortRowsInto(PortHandle Handle, unsigned FirstRow, unsigned Count,
+                                uint8_t* Buf, size_t Len) = 0;
+
+  /// VerilatorSSTBase: read the rows of the target port handle that changed since the previous call;
+  /// the row indices (ascending) are stored in Rows and their packed values in Data, both cleared first.
+  /// The first call on a port reports every row. Returns the number of changed rows.
+  virtual size_t readPortChanges(PortHandle Handle, std::vector<uint32_t>& Rows,
+                                 std::vector<uint8_t>& Data) = 0;
+
+  /// VerilatorSSTBase: load a binary, $readmemh or ELF image file into the target port or probe,
+  /// bypassing VPI and statistics; ELF segments land at byte p_paddr - ElfBase of the packed rows.
+  /// Returns the number of rows loaded
+  virtual uint64_t loadMemory(PortHandle Handle, const std::string& Path, uint64_t ElfBase = 0) = 0;
+
+  /// VerilatorSSTBase: write every row of the target port or probe to Path as raw packed rows
+  virtual void dumpMemory(PortHandle Handle, const std::string& Path) = 0;
 
 protected:
   SST::Output *output;        ///< VerilatorSST: SST output handler